@@ -25,9 +25,11 @@ int main() {
     // pca.fit(df, true);
     // Oder es kann eine schon berechnete Kovarianzmatrix benutzt werden
     // DataFrame dfCov = descriptiveStatistics::covariances(df);
-    // pca.fit(dfCov, false, false, true);
-    // Die PCA kann statt mit der Spektralzerlegung auch mit der SVD berechnet werden, für die Originalen Daten df
-    // pca.fit(dfCov, true, true);
+    // pca.fit(dfCov, false, PcaSolver::CovarianceEigen, true);
+    // Der Solver wird standardmäßig automatisch gewählt, er kann aber auch vorgegeben werden, z.B. die SVD der Originalen Daten df
+    // pca.fit(df, true, PcaSolver::BDC);
+    // Werden nur wenige Komponenten gebraucht, können nur diese berechnet werden (hier 2, z.B. mit der randomisierten SVD)
+    // pca.fit(df, true, PcaSolver::Randomized, false, 2);
 
 
     // Bekomme und printe die Informationen der Eigenzerlegung
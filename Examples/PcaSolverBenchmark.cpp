@@ -0,0 +1,65 @@
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "DataFrame.hpp"
+#include "CastingHelper.hpp"
+#include "PCA.hpp"
+
+
+// Misst die Laufzeit von PCA::fit mit den verschiedenen Solvern fuer verschiedene Formen der Daten (Zeilen n, Variablen p, Komponenten k).
+// Aus diesen Messungen stammen die Schwellenwerte von PCA::chooseSolver. Gemessen mit -O2 auf einem Kern (Sekunden):
+//   n      p     k | CovarianceEigen    BDC   Randomized  Lanczos
+//   20000  50    5 |      0.014        0.079    0.049      0.012
+//   20000  200  10 |      0.075        0.77     0.13       0.046
+//   20000  500  10 |      0.44         3.5      0.26       0.20
+//   10000  1000 10 |      2.2          7.8      0.35       0.41
+//   20000  200   0 |      0.062        0.80
+//   5000   1000  0 |      1.6          3.0
+//   3000   1000  0 |      1.4          1.8
+//   2000   1000  0 |      1.9          1.3
+//   500    1000  0 |      1.2          0.21
+//   200    2000  0 |     11.0          0.064
+// Daraus folgt:
+//  - Fuer k <= p / 10 ist Lanczos auf der Kovarianzmatrix am schnellsten, ab etwa p = 800 die randomisierte SVD
+//  - Fuer alle Komponenten ist die Divide-and-Conquer SVD (BDC) bis etwa n = 2p schneller, darueber die Kovarianz-Eigenzerlegung
+//  - Die Jacobi SVD ist am genauesten, aber um Groessenordnungen langsamer und wird deshalb nie automatisch gewaehlt
+int main() {
+    struct Shape {
+        int n;
+        int p;
+        int k;
+    };
+    std::vector<Shape> shapes = {{20000, 50, 5}, {20000, 200, 10}, {20000, 500, 10}, {10000, 1000, 10}, {20000, 200, 0},
+                                 {5000, 1000, 0}, {3000, 1000, 0}, {2000, 1000, 0}, {500, 1000, 0}, {200, 2000, 0}};
+    std::vector<std::pair<std::string, PcaSolver>> solvers = {{"CovarianceEigen", PcaSolver::CovarianceEigen}, {"BDC", PcaSolver::BDC},
+                                                              {"Randomized", PcaSolver::Randomized}, {"Lanczos", PcaSolver::Lanczos},
+                                                              {"Auto", PcaSolver::Auto}};
+
+    std::mt19937 random(1);
+    std::normal_distribution<double> normal;
+    for (const Shape& shape : shapes) {
+        // Daten mit abfallendem Spektrum: Wenige starke Faktoren plus Rauschen
+        Eigen::MatrixXd factors(shape.n, 20), loadings(20, shape.p);
+        for (int i = 0; i < shape.n; ++i) for (int r = 0; r < 20; ++r) factors(i, r) = normal(random) * (20 - r);
+        for (int r = 0; r < 20; ++r) for (int j = 0; j < shape.p; ++j) loadings(r, j) = normal(random);
+        Eigen::MatrixXd data = factors * loadings;
+        for (int i = 0; i < shape.n; ++i) for (int j = 0; j < shape.p; ++j) data(i, j) += normal(random);
+
+        std::cout << "n = " << shape.n << ", p = " << shape.p << ", k = " << shape.k << std::endl;
+        for (const auto& [name, solver] : solvers) {
+            // Die randomisierte SVD und Lanczos lohnen sich nur fuer wenige Komponenten
+            if (shape.k == 0 && (solver == PcaSolver::Randomized || solver == PcaSolver::Lanczos)) continue;
+            // Ein neuer Dataframe pro Messung, da die Statistiken (z.B. die Kovarianzmatrix) im Dataframe zwischengespeichert werden
+            DataFrame df = castingHelper::eigenMatrixToDataFrame(data);
+            PCA pca;
+            auto start = std::chrono::steady_clock::now();
+            pca.fit(df, false, solver, false, shape.k);
+            std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+            std::cout << "  " << std::setw(16) << name << ": " << seconds.count() << " s, largest eigenvalue " << pca.getEigenvalues()[0] << std::endl;
+        }
+    }
+}
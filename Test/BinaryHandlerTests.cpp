@@ -0,0 +1,87 @@
+#include "catch2/catch.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+#include "DataFrame.hpp"
+#include "Column.hpp"
+#include "BinaryHandler.hpp"
+#include "CsvHandler.hpp"
+
+
+TEST_CASE("Binary format round trip", "[binaryHandler]") {
+    std::string filename = (std::filesystem::temp_directory_path() / "miniml_binary_test.bin").string();
+
+    DataFrame df({
+        {"I", {1.0, 2.0, 3.0}},
+        {"F", {1.5, 2.5, 3.5}},
+        {"D", {0.1, 0.2, 0.3}}
+    }, {}, {ColumnType::Int, ColumnType::Float, ColumnType::Double});
+
+    SECTION("Values, names and types are kept") {
+        binaryHandler::save(df, filename);
+        DataFrame loaded = binaryHandler::load(filename);
+
+        REQUIRE(loaded.getDim() == df.getDim());
+        REQUIRE(loaded.getColNames() == df.getColNames());
+        REQUIRE_FALSE(loaded.hasRowNames());
+        for (int col = 0; col < 3; ++col) {
+            REQUIRE(loaded.getColumnType(col) == df.getColumnType(col));
+            REQUIRE(loaded.getColumn(col).getDataAsDouble() == df.getColumn(col).getDataAsDouble());
+        }
+    }
+
+    SECTION("Explicit row names are kept") {
+        df.setRowNames({"a", "b", "c"});
+        binaryHandler::save(df, filename);
+        DataFrame loaded = binaryHandler::load(filename);
+
+        REQUIRE(loaded.getRowNames() == std::vector<std::string>{"a", "b", "c"});
+        REQUIRE(loaded.get("b", "F") == 2.5);
+    }
+
+    SECTION("Loaded columns are aligned and can be modified") {
+        binaryHandler::save(df, filename);
+        DataFrame loaded = binaryHandler::load(filename);
+
+        REQUIRE(reinterpret_cast<std::uintptr_t>(loaded.getColumn("D").getSpan<double>().data()) % 64 == 0);
+        loaded.set(42.0, 1, "D");
+        loaded.dropRow(0);
+        REQUIRE(loaded.get(0, "D") == 42.0);
+        REQUIRE(loaded.getDim().first == 2);
+    }
+
+    SECTION("Iris data set") {
+        DataFrame iris = csvHandler::fromCSV("../../Data/Iris.txt");
+        binaryHandler::save(iris, filename);
+        DataFrame loaded = binaryHandler::load(filename);
+
+        REQUIRE(loaded.getDim() == iris.getDim());
+        for (int col = 0; col < iris.getDim().second; ++col) {
+            REQUIRE(loaded.getColumn(col).getDataAsDouble() == iris.getColumn(col).getDataAsDouble());
+        }
+    }
+
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("Binary format rejects invalid files", "[binaryHandler][throws]") {
+    std::string filename = (std::filesystem::temp_directory_path() / "miniml_binary_invalid.bin").string();
+
+    REQUIRE_THROWS_AS(binaryHandler::load(filename + ".missing"), std::runtime_error);
+
+    SECTION("Wrong magic") {
+        std::ofstream(filename) << "not a binary DataFrame";
+        REQUIRE_THROWS_AS(binaryHandler::load(filename), std::runtime_error);
+    }
+
+    SECTION("Truncated file") {
+        DataFrame df({{"A", {1.0, 2.0, 3.0}}});
+        binaryHandler::save(df, filename);
+        std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 8);
+        REQUIRE_THROWS_AS(binaryHandler::load(filename), std::runtime_error);
+    }
+
+    std::filesystem::remove(filename);
+}
@@ -0,0 +1,389 @@
+#include "catch2/catch.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include "DataFrame.hpp"
+#include "CsvHandler.hpp"
+
+
+namespace {
+    std::string writeCsv(const std::string& name, const std::string& content) {
+        std::string filename = (std::filesystem::temp_directory_path() / name).string();
+        std::ofstream(filename, std::ios::binary) << content;
+        return filename;
+    }
+
+    std::string errorMessage(const std::string& filename) {
+        try {
+            csvHandler::fromCSV(filename);
+        } catch (const std::runtime_error& e) {
+            return e.what();
+        }
+        return "";
+    }
+}
+
+
+TEST_CASE("fromCSV parses values, headers and row names", "[csvHandler][fromCSV]") {
+
+    SECTION("Iris data set") {
+        DataFrame iris = csvHandler::fromCSV("../../Data/Iris.txt");
+        REQUIRE(iris.getDim() == std::pair<int, int>{150, 4});
+        REQUIRE(iris.getColNames() == std::vector<std::string>{"sepal.length", "sepal.width", "petal.length", "petal.width"});
+        REQUIRE(iris.get(0, 0) == 5.1);
+        REQUIRE(iris.get(149, 3) == 1.8);
+    }
+
+    SECTION("Row names, other delimiter, whitespace and windows line endings") {
+        std::string filename = writeCsv("miniml_csv_rownames.csv", "id; A ; B\r\nfirst;1.5; -2\r\nsecond; +3;4e2\r\n");
+        DataFrame df = csvHandler::fromCSV(filename, true, ';');
+        REQUIRE(df.getColNames() == std::vector<std::string>{"A", "B"});
+        REQUIRE(df.getRowNames() == std::vector<std::string>{"first", "second"});
+        REQUIRE(df.get("first", "B") == -2.0);
+        REQUIRE(df.get("second", "A") == 3.0);
+        REQUIRE(df.get("second", "B") == 400.0);
+        std::filesystem::remove(filename);
+    }
+
+    SECTION("Missing newline at the end of the file") {
+        std::string filename = writeCsv("miniml_csv_nonewline.csv", "A,B\n1,2\n3,4");
+        DataFrame df = csvHandler::fromCSV(filename);
+        REQUIRE(df.getDim() == std::pair<int, int>{2, 2});
+        REQUIRE(df.get(1, "B") == 4.0);
+        std::filesystem::remove(filename);
+    }
+}
+
+TEST_CASE("fromCSV reports malformed rows", "[csvHandler][fromCSV][throws]") {
+
+    SECTION("Too many values") {
+        std::string filename = writeCsv("miniml_csv_toomany.csv", "A,B\n1,2\n3,4,5\n");
+        REQUIRE(errorMessage(filename) == "Too many values in row 1");
+        std::filesystem::remove(filename);
+    }
+
+    SECTION("Too few values") {
+        std::string filename = writeCsv("miniml_csv_toofew.csv", "A,B\n1,2\n3,4\n5\n");
+        REQUIRE(errorMessage(filename) == "Too few values in row 2");
+        std::filesystem::remove(filename);
+    }
+
+    SECTION("Not numeric") {
+        std::string filename = writeCsv("miniml_csv_text.csv", "A,B\n1,x\n");
+        REQUIRE(errorMessage(filename) == "Failed to convert value: 'x' at row 0");
+        std::filesystem::remove(filename);
+    }
+
+    SECTION("Missing file") {
+        REQUIRE_THROWS_AS(csvHandler::fromCSV("does_not_exist.csv"), std::runtime_error);
+    }
+}
+
+TEST_CASE("fromCSV with multiple threads", "[csvHandler][fromCSV][parallel]") {
+    // Large enough, that the file is split into several chunks
+    const int nrRows = 200000;
+    std::string content = "name,A,B\n";
+    for (int i = 0; i < nrRows; ++i) {
+        content += "row" + std::to_string(i) + "," + std::to_string(i) + "," + std::to_string(i * 0.5) + "\n";
+    }
+    std::string filename = writeCsv("miniml_csv_parallel.csv", content);
+
+    csvHandler::CsvReadOptions options;
+    options.hasRowNames = true;
+    options.numThreads = 4;
+
+    SECTION("Same result as a single thread") {
+        DataFrame parallel = csvHandler::fromCSV(filename, options);
+        DataFrame sequential = csvHandler::fromCSV(filename, true);
+
+        REQUIRE(parallel.getDim() == std::pair<int, int>{nrRows, 2});
+        REQUIRE(parallel.getColumn("A").getDataAsDouble() == sequential.getColumn("A").getDataAsDouble());
+        REQUIRE(parallel.getColumn("B").getDataAsDouble() == sequential.getColumn("B").getDataAsDouble());
+        REQUIRE(parallel.getRowNames() == sequential.getRowNames());
+        REQUIRE(parallel.get("row123456", "A") == 123456.0);
+    }
+
+    SECTION("Errors report the global row number") {
+        std::string faulty = content;
+        std::string line = "row150000,150000,75000.000000\n";
+        faulty.replace(faulty.find(line), line.size(), "row150000,150000\n");
+        std::string faultyFile = writeCsv("miniml_csv_parallel_faulty.csv", faulty);
+
+        try {
+            csvHandler::fromCSV(faultyFile, options);
+            FAIL("No exception thrown");
+        } catch (const std::runtime_error& e) {
+            REQUIRE(std::string(e.what()) == "Too few values in row 150000");
+        }
+        std::filesystem::remove(faultyFile);
+    }
+
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("fromCSV reads only selected columns and rows", "[csvHandler][fromCSV][selection]") {
+    DataFrame iris = csvHandler::fromCSV("../../Data/Iris.txt");
+
+    SECTION("Columns by name in the given order") {
+        csvHandler::CsvReadOptions options;
+        options.columns = {"petal.width", "sepal.length"};
+        DataFrame df = csvHandler::fromCSV("../../Data/Iris.txt", options);
+        REQUIRE(df.getDim() == std::pair<int, int>{150, 2});
+        REQUIRE(df.getColNames() == std::vector<std::string>{"petal.width", "sepal.length"});
+        REQUIRE(df.get(149, 0) == iris.get(149, 3));
+        REQUIRE(df.get(149, 1) == iris.get(149, 0));
+    }
+
+    SECTION("Columns by index and a row range") {
+        csvHandler::CsvReadOptions options;
+        options.columnIndices = {2};
+        options.skipRows = 10;
+        options.maxRows = 5;
+        options.numThreads = 2;
+        DataFrame df = csvHandler::fromCSV("../../Data/Iris.txt", options);
+        REQUIRE(df.getDim() == std::pair<int, int>{5, 1});
+        for (int row = 0; row < 5; ++row) {
+            REQUIRE(df.get(row, 0) == iris.get(row + 10, 2));
+        }
+    }
+
+    SECTION("Rows at the end of the file") {
+        csvHandler::CsvReadOptions options;
+        options.skipRows = 148;
+        options.maxRows = 10;
+        REQUIRE(csvHandler::fromCSV("../../Data/Iris.txt", options).getDim() == std::pair<int, int>{2, 4});
+        options.skipRows = 200;
+        REQUIRE(csvHandler::fromCSV("../../Data/Iris.txt", options).getDim() == std::pair<int, int>{0, 4});
+    }
+
+    SECTION("Skipped values are not parsed, but the row structure is checked") {
+        std::string filename = writeCsv("miniml_csv_selection.csv", "A,B,C\n1,x,2\n3,y,4\n5,6\n");
+        csvHandler::CsvReadOptions options;
+        options.columns = {"C", "A"};
+        options.maxRows = 2;
+        DataFrame df = csvHandler::fromCSV(filename, options);
+        REQUIRE(df.get(1, "C") == 4.0);
+        REQUIRE(df.get(1, "A") == 3.0);
+
+        options.maxRows = -1;
+        options.skipRows = 1;
+        try {
+            csvHandler::fromCSV(filename, options);
+            FAIL("No exception thrown");
+        } catch (const std::runtime_error& e) {
+            REQUIRE(std::string(e.what()) == "Too few values in row 2");
+        }
+        std::filesystem::remove(filename);
+    }
+
+    SECTION("Invalid selections") {
+        csvHandler::CsvReadOptions options;
+        options.columns = {"sepal.length"};
+        options.columnIndices = {0};
+        REQUIRE_THROWS_AS(csvHandler::fromCSV("../../Data/Iris.txt", options), std::invalid_argument);
+        options.columnIndices.clear();
+        options.columns = {"unknown"};
+        REQUIRE_THROWS_AS(csvHandler::fromCSV("../../Data/Iris.txt", options), std::invalid_argument);
+        options.columns.clear();
+        options.columnIndices = {4};
+        REQUIRE_THROWS_AS(csvHandler::fromCSV("../../Data/Iris.txt", options), std::invalid_argument);
+        options.columnIndices.clear();
+        options.skipRows = -1;
+        REQUIRE_THROWS_AS(csvHandler::fromCSV("../../Data/Iris.txt", options), std::invalid_argument);
+    }
+}
+
+TEST_CASE("fromCSV infers narrow column types", "[csvHandler][fromCSV][inferTypes]") {
+    std::string filename = writeCsv("miniml_csv_types.csv",
+        "I,F,D,N\n1,0.5,0.1,2\n-2,1.25,1e300,3\n3.0,-8,2,4.5\n4,3e9,3,5\n");
+    csvHandler::CsvReadOptions options;
+
+    SECTION("Double without inference") {
+        DataFrame df = csvHandler::fromCSV(filename, options);
+        for (int col = 0; col < 4; ++col) {
+            REQUIRE(df.getColumnType(col) == ColumnType::Double);
+        }
+    }
+
+    SECTION("Narrowest lossless type") {
+        options.inferTypes = true;
+        DataFrame df = csvHandler::fromCSV(filename, options);
+        REQUIRE(df.getColumnType("I") == ColumnType::Int);
+        REQUIRE(df.getColumnType("F") == ColumnType::Float);
+        REQUIRE(df.getColumnType("D") == ColumnType::Double);
+        REQUIRE(df.getColumnType("N") == ColumnType::Float);
+        REQUIRE(df.get(1, "I") == -2.0);
+        REQUIRE(df.get(3, "F") == 3e9);
+        REQUIRE(df.get(0, "D") == 0.1);
+    }
+
+    SECTION("Tolerance allows float for inexact values") {
+        options.inferTypes = true;
+        options.floatTolerance = 1e-6;
+        DataFrame df = csvHandler::fromCSV(filename, options);
+        REQUIRE(df.getColumnType("D") == ColumnType::Double);
+        options.columns = {"D"};
+        options.maxRows = 1;
+        df = csvHandler::fromCSV(filename, options);
+        REQUIRE(df.getColumnType("D") == ColumnType::Float);
+        REQUIRE(df.get(0, "D") == Approx(0.1).epsilon(1e-6));
+    }
+
+    SECTION("Sampled inference falls back, if later rows do not fit") {
+        options.inferTypes = true;
+        options.inferenceSampleRows = 2;
+        DataFrame df = csvHandler::fromCSV(filename, options);
+        REQUIRE(df.getColumnType("I") == ColumnType::Int);
+        REQUIRE(df.getColumnType("N") == ColumnType::Float);
+        REQUIRE(df.get(2, "N") == 4.5);
+    }
+
+    SECTION("Invalid tolerance") {
+        options.floatTolerance = -1.0;
+        REQUIRE_THROWS_AS(csvHandler::fromCSV(filename, options), std::invalid_argument);
+    }
+
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("toCSV writes values, headers and row names", "[csvHandler][toCSV]") {
+    std::string filename = (std::filesystem::temp_directory_path() / "miniml_csv_write.csv").string();
+
+    auto readFile = [&]() {
+        std::ifstream in(filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+
+    SECTION("All column types in their shortest form") {
+        DataFrame df({{"I", {1, -2}}, {"F", {0.1, 2.5}}, {"D", {0.1, 1e-300}}}, {}, {ColumnType::Int, ColumnType::Float, ColumnType::Double});
+        csvHandler::toCSV(df, filename);
+        REQUIRE(readFile() == "I,F,D\n1,0.1,0.1\n-2,2.5,1e-300\n");
+    }
+
+    SECTION("Row names and other delimiter") {
+        DataFrame df({{"A", {1.5}}, {"B", {2}}}, {"first"});
+        csvHandler::toCSV(df, filename, true, ';');
+        REQUIRE(readFile() == "RowNames;A;B\nfirst;1.5;2\n");
+    }
+
+    SECTION("Values read back exactly") {
+        DataFrame iris = csvHandler::fromCSV("../../Data/Iris.txt");
+        csvHandler::toCSV(iris, filename);
+        DataFrame loaded = csvHandler::fromCSV(filename);
+        REQUIRE(loaded.getDim() == iris.getDim());
+        for (int col = 0; col < 4; ++col) {
+            REQUIRE(loaded.getColumn(col).getDataAsDouble() == iris.getColumn(col).getDataAsDouble());
+        }
+    }
+
+    SECTION("Multiple threads write the same file as a single thread") {
+        std::vector<double> a, b;
+        for (int i = 0; i < 100000; ++i) {
+            a.push_back(i / 7.0);
+            b.push_back(-i * 1e10);
+        }
+        DataFrame df({{"A", a}, {"B", b}});
+        csvHandler::CsvWriteOptions options;
+        options.includeRowNames = true;
+        csvHandler::toCSV(df, filename, options);
+        std::string single = readFile();
+        options.numThreads = 4;
+        csvHandler::toCSV(df, filename, options);
+        REQUIRE(readFile() == single);
+
+        DataFrame loaded = csvHandler::fromCSV(filename, true);
+        REQUIRE(loaded.getRowName(99999) == "R99999");
+        REQUIRE(loaded.getColumn("A").getDataAsDouble() == a);
+        REQUIRE(loaded.getColumn("B").getDataAsDouble() == b);
+    }
+
+    std::filesystem::remove(filename);
+}
+
+TEST_CASE("CsvBatchReader reads a file in batches", "[csvHandler][CsvBatchReader]") {
+    DataFrame iris = csvHandler::fromCSV("../../Data/Iris.txt");
+
+    SECTION("Batches cover all rows in order") {
+        csvHandler::CsvBatchReader reader("../../Data/Iris.txt", 40);
+        REQUIRE(reader.getColNames() == iris.getColNames());
+
+        DataFrame batch;
+        std::vector<int> batchSizes;
+        int row = 0;
+        while (reader.next(batch)) {
+            batchSizes.push_back(batch.getDim().first);
+            for (int i = 0; i < batch.getDim().first; ++i, ++row) {
+                for (int col = 0; col < 4; ++col) {
+                    REQUIRE(batch.get(i, col) == iris.get(row, col));
+                }
+            }
+        }
+        REQUIRE(batchSizes == std::vector<int>{40, 40, 40, 30});
+        REQUIRE(reader.getRowsRead() == 150);
+        REQUIRE(batch.empty());
+    }
+
+    SECTION("Buffers are reused, if the old batch is not used anymore") {
+        csvHandler::CsvBatchReader reader("../../Data/Iris.txt", 50);
+        DataFrame batch;
+        reader.next(batch);
+        const double* first = batch.getColumn(0).getSpan<double>().data();
+        reader.next(batch);
+        REQUIRE(batch.getColumn(0).getSpan<double>().data() == first);
+
+        // A batch which is still used keeps its values
+        DataFrame kept = batch;
+        reader.next(batch);
+        REQUIRE(kept.get(0, 0) == iris.get(50, 0));
+        REQUIRE(batch.get(0, 0) == iris.get(100, 0));
+    }
+
+    SECTION("Column selection and row range") {
+        csvHandler::CsvReadOptions options;
+        options.columns = {"petal.length"};
+        options.skipRows = 5;
+        options.maxRows = 100;
+        csvHandler::CsvBatchReader reader("../../Data/Iris.txt", 30, options);
+        REQUIRE(reader.getColNames() == std::vector<std::string>{"petal.length"});
+
+        DataFrame batch;
+        std::vector<int> batchSizes;
+        int row = 5;
+        while (reader.next(batch)) {
+            batchSizes.push_back(batch.getDim().first);
+            REQUIRE(batch.getDim().second == 1);
+            for (int i = 0; i < batch.getDim().first; ++i, ++row) {
+                REQUIRE(batch.get(i, 0) == iris.get(row, 2));
+            }
+        }
+        REQUIRE(batchSizes == std::vector<int>{30, 30, 30, 10});
+        REQUIRE(reader.getRowsRead() == 100);
+    }
+
+    SECTION("Lines longer than a block and errors with global row numbers") {
+        std::string content = "name,A\n";
+        for (int i = 0; i < 7; ++i) content += "r" + std::to_string(i) + "," + std::to_string(i) + "\n";
+        content += std::string(5 << 20, 'x') + ",1\n";
+        content += "last,1,2";
+        std::string filename = writeCsv("miniml_csv_batches.csv", content);
+
+        csvHandler::CsvReadOptions options;
+        options.hasRowNames = true;
+        csvHandler::CsvBatchReader reader(filename, 4, options);
+        DataFrame batch;
+        REQUIRE(reader.next(batch));
+        REQUIRE(batch.getRowNames() == std::vector<std::string>{"r0", "r1", "r2", "r3"});
+        REQUIRE(reader.next(batch));
+        REQUIRE(batch.getDim().first == 4);
+        REQUIRE(batch.get(3, "A") == 1.0);
+        try {
+            reader.next(batch);
+            FAIL("No exception thrown");
+        } catch (const std::runtime_error& e) {
+            REQUIRE(std::string(e.what()) == "Too many values in row 8");
+        }
+        std::filesystem::remove(filename);
+    }
+}
@@ -5,6 +5,8 @@
 #include "DataFrame.hpp"
 #include "Column.hpp"
 
+#include <utility>
+
 
 
 TEST_CASE("DataFrame insert and recall operations", "[DataFrame]") {
@@ -160,3 +162,195 @@ TEST_CASE("Concatenate throws when row counts differ", "[DataFrame][concatenate]
 
 
 
+TEST_CASE("Column gives typed access to its data without copying", "[Column][getSpan]") {
+    DataFrame df({
+        {"I", {1.0, 2.0, 3.0}},
+        {"F", {1.5, 2.5, 3.5}},
+        {"D", {0.1, 0.2, 0.3}}
+    }, {}, {ColumnType::Int, ColumnType::Float, ColumnType::Double});
+
+    SECTION("Span has the storage type of the column") {
+        std::span<const int> ints = df.getColumn("I").getSpan<int>();
+        REQUIRE(ints.size() == 3);
+        REQUIRE(ints[2] == 3);
+        std::span<const float> floats = df.getColumn("F").getSpan<float>();
+        REQUIRE(floats[0] == 1.5f);
+    }
+
+    SECTION("Span points to the data of the DataFrame") {
+        const double* first = df.getColumn("D").getSpan<double>().data();
+        REQUIRE(df.getColumn("D").getSpan<double>().data() == first);
+    }
+
+    SECTION("Span with wrong type throws") {
+        REQUIRE_THROWS_AS(df.getColumn("I").getSpan<double>(), std::invalid_argument);
+    }
+
+    SECTION("Visitor gets the native type") {
+        double sum = 0;
+        for (int col = 0; col < 3; ++col) {
+            sum += df.getColumn(col).visit([](auto data) {
+                double colSum = 0;
+                for (auto val : data) colSum += val;
+                return colSum;
+            });
+        }
+        REQUIRE(sum == Approx(6.0 + 7.5 + 0.6));
+    }
+}
+
+TEST_CASE("Column copies share storage until they are modified", "[Column][copyOnWrite]") {
+    DataFrame df({
+        {"A", {1.0, 2.0, 3.0}},
+        {"B", {4.0, 5.0, 6.0}}
+    });
+
+    SECTION("Copy of a column shares its data") {
+        Column copy = df.getColumn("A");
+        REQUIRE(copy.isShared());
+        REQUIRE(std::as_const(copy).getSpan<double>().data() == df.getColumn("A").getSpan<double>().data());
+    }
+
+    SECTION("Modifying a copy does not change the original") {
+        Column copy = df.getColumn("A");
+        copy.setAt(42.0, 1);
+        REQUIRE(copy.getDataAtAsDouble(1) == 42.0);
+        REQUIRE(df.get(1, "A") == 2.0);
+        REQUIRE_FALSE(copy.isShared());
+    }
+
+    SECTION("Modifying the DataFrame does not change a copy") {
+        Column copy = df.getColumn("B");
+        df.set(42.0, 0, "B");
+        REQUIRE(df.get(0, "B") == 42.0);
+        REQUIRE(copy.getDataAtAsDouble(0) == 4.0);
+    }
+
+    SECTION("Subset with all rows shares the columns with its parent") {
+        std::vector<int> rows = {0, 1, 2};
+        std::vector<std::string> cols = {"B"};
+        DataFrame subset = df.get(rows, cols);
+        REQUIRE(subset.getColumn("B").getSpan<double>().data() == df.getColumn("B").getSpan<double>().data());
+        subset.set(0.0, 2, "B");
+        REQUIRE(df.get(2, "B") == 6.0);
+        REQUIRE(subset.get(2, "B") == 0.0);
+    }
+}
+
+TEST_CASE("Column directory keeps positions and names consistent", "[DataFrame][columnDirectory]") {
+    DataFrame df({
+        {"A", {1.0, 2.0}},
+        {"B", {3.0, 4.0}},
+        {"C", {5.0, 6.0}}
+    });
+
+    SECTION("Index access after dropping a column") {
+        df.dropColumn(0);
+        REQUIRE(df.get(0, 0) == 3.0);
+        REQUIRE(df.get(1, "C") == 6.0);
+        REQUIRE(df.getColumn(1).getDataAsDouble() == std::vector<double>{5.0, 6.0});
+    }
+
+    SECTION("Renaming keeps the data at its position") {
+        const double* data = df.getColumn(1).getSpan<double>().data();
+        df.setColNames({"X", "Y", "Z"});
+        REQUIRE(df.getColNames() == std::vector<std::string>{"X", "Y", "Z"});
+        REQUIRE(df.get(1, "Y") == 4.0);
+        REQUIRE(df.getColumn("Y").getSpan<double>().data() == data);
+        REQUIRE_THROWS_AS(df.getColumn("B"), std::invalid_argument);
+    }
+
+    SECTION("Row values follow column order") {
+        REQUIRE(df.getRow(1) == std::vector<double>{2.0, 4.0, 6.0});
+    }
+
+    SECTION("Duplicate column names are rejected") {
+        REQUIRE_THROWS_AS(df.setColNames({"X", "X", "Z"}), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Implicit row names", "[DataFrame][rowNames]") {
+    DataFrame df({
+        {"A", {1.0, 2.0, 3.0}},
+        {"B", {4.0, 5.0, 6.0}}
+    });
+
+    SECTION("Rows are labeled by position without storing names") {
+        REQUIRE_FALSE(df.hasRowNames());
+        REQUIRE(df.getRowName(2) == "R2");
+        REQUIRE(df.getRowNames() == std::vector<std::string>{"R0", "R1", "R2"});
+        REQUIRE(df.get("R1", "B") == 5.0);
+        REQUIRE_THROWS_AS(df.get("R3", "B"), std::invalid_argument);
+        REQUIRE_THROWS_AS(df.get("X1", "B"), std::invalid_argument);
+    }
+
+    SECTION("Adding rows without a name keeps the names implicit") {
+        std::vector<double> row = {7.0, 8.0};
+        df.addRow(row);
+        REQUIRE_FALSE(df.hasRowNames());
+        REQUIRE(df.get("R3", "A") == 7.0);
+    }
+
+    SECTION("Adding a named row makes the names explicit") {
+        std::vector<double> row = {7.0, 8.0};
+        df.addRow(row, "Named");
+        REQUIRE(df.hasRowNames());
+        REQUIRE(df.getRowNames() == std::vector<std::string>{"R0", "R1", "R2", "Named"});
+        REQUIRE(df.get("Named", "B") == 8.0);
+    }
+
+    SECTION("Dropping a row keeps the labels of the other rows") {
+        std::string row = "R0";
+        df.dropRow(row);
+        REQUIRE(df.getRowNames() == std::vector<std::string>{"R1", "R2"});
+        REQUIRE(df.get("R2", "A") == 3.0);
+    }
+}
+
+
+TEST_CASE("Versions change with every modification", "[DataFrame][version]") {
+    DataFrame df({
+        {"A", {1.0, 2.0, 3.0}},
+        {"B", {4.0, 5.0, 6.0}}
+    });
+    std::uint64_t version = df.getVersion();
+    std::uint64_t versionA = df.getColumn("A").getVersion();
+
+    SECTION("Reading does not change the version") {
+        df.get(0, "A");
+        df.getColumn("A").getSpan<double>();
+        REQUIRE(df.getVersion() == version);
+        REQUIRE(df.getColumn("A").getVersion() == versionA);
+    }
+
+    SECTION("Setting a value changes the versions of the DataFrame and the column") {
+        df.set(42.0, 0, "A");
+        REQUIRE(df.getVersion() != version);
+        REQUIRE(df.getColumn("A").getVersion() != versionA);
+    }
+
+    SECTION("Structural modifications change the version") {
+        std::vector<double> row = {7.0, 8.0};
+        df.addRow(row);
+        REQUIRE(df.getVersion() != version);
+        version = df.getVersion();
+        df.dropRow(0);
+        REQUIRE(df.getVersion() != version);
+        version = df.getVersion();
+        df.setColNames({"C", "D"});
+        REQUIRE(df.getVersion() != version);
+        version = df.getVersion();
+        df.dropColumn(0);
+        REQUIRE(df.getVersion() != version);
+    }
+
+    SECTION("Copies keep the version until they are modified") {
+        DataFrame copy = df;
+        Column col = df.getColumn("A");
+        REQUIRE(copy.getVersion() == version);
+        REQUIRE(col.getVersion() == versionA);
+        col.setAt(0.0, 0);
+        REQUIRE(col.getVersion() != versionA);
+        REQUIRE(df.getColumn("A").getVersion() == versionA);
+    }
+}
@@ -1,6 +1,10 @@
 
+
 #include "catch2/catch.hpp"
 
+#include <cmath>
+#include <limits>
+
 #include "DataFrame.hpp"
 #include "Column.hpp"
 #include "DescriptiveStatistics.hpp"
@@ -128,6 +132,83 @@ TEST_CASE("Covariance matrix calculation", "[descriptiveStatistics][covariances]
     }
 }
 
+TEST_CASE("Covariance matrix over several row tiles", "[descriptiveStatistics][covariances]") {
+    // 64 columns give tiles of 16384 rows, so the rows are processed in 3 tiles
+    const int n = 40000;
+    const int p = 64;
+    std::vector<std::pair<std::string, std::vector<double>>> columns;
+    for (int col = 0; col < p; ++col) {
+        std::vector<double> values(n);
+        for (int row = 0; row < n; ++row) values[row] = std::sin(row * (col + 1) * 0.001) + 1000.0 + col;
+        columns.emplace_back("C" + std::to_string(col), values);
+    }
+    DataFrame df(columns);
+    Eigen::MatrixXd cov = descriptiveStatistics::covariancesEigen(df);
+
+    REQUIRE(cov.rows() == p);
+    REQUIRE(cov.isApprox(cov.transpose()));
+    for (int i : {0, 37, 63}) {
+        for (int j : {0, 13, 63}) {
+            std::vector<double>& x = columns[i].second;
+            std::vector<double>& y = columns[j].second;
+            double meanX = 0, meanY = 0;
+            for (int row = 0; row < n; ++row) {
+                meanX += x[row] / n;
+                meanY += y[row] / n;
+            }
+            double expected = 0;
+            for (int row = 0; row < n; ++row) expected += (x[row] - meanX) * (y[row] - meanY);
+            REQUIRE(cov(i, j) == Approx(expected / (n - 1)).epsilon(1e-9));
+        }
+    }
+}
+
+TEST_CASE("Covariance accumulator over batches", "[descriptiveStatistics][CovarianceAccumulator]") {
+    DataFrame iris = csvHandler::fromCSV("../../Data/Iris.txt");
+    Eigen::MatrixXd expected = descriptiveStatistics::covariancesEigen(iris);
+
+    auto rowsOf = [&](int first, int last) {
+        std::vector<int> rows, cols = {0, 1, 2, 3};
+        for (int row = first; row < last; ++row) rows.push_back(row);
+        return iris.get(rows, cols);
+    };
+
+    SECTION("Batches give the covariance of all rows") {
+        descriptiveStatistics::CovarianceAccumulator accumulator;
+        for (int first = 0; first < 150; first += 40) {
+            accumulator.add(rowsOf(first, std::min(150, first + 40)));
+        }
+        REQUIRE(accumulator.getCount() == 150);
+        REQUIRE(accumulator.covariancesEigen().isApprox(expected, 1e-12));
+        REQUIRE(accumulator.getMeans()[0] == Approx(5.843333).epsilon(0.0001));
+    }
+
+    SECTION("Merged accumulators and serialized states") {
+        descriptiveStatistics::CovarianceAccumulator first, second;
+        first.add(rowsOf(0, 100));
+        second.add(rowsOf(100, 150));
+        descriptiveStatistics::CovarianceAccumulator restored = descriptiveStatistics::CovarianceAccumulator::deserialize(second.serialize());
+        REQUIRE(restored.getColNames() == iris.getColNames());
+        first.merge(restored);
+        REQUIRE(first.covariancesEigen().isApprox(expected, 1e-12));
+
+        DataFrame cov = first.covariances();
+        REQUIRE(cov.get("petal.length", "sepal.length") == Approx(1.27431543624161).epsilon(0.0001));
+    }
+
+    SECTION("Invalid input") {
+        descriptiveStatistics::CovarianceAccumulator accumulator;
+        REQUIRE_THROWS_AS(accumulator.covariancesEigen(), std::invalid_argument);
+        accumulator.add(iris);
+        DataFrame other({{"A", {1.0, 2.0}}});
+        REQUIRE_THROWS_AS(accumulator.add(other), std::invalid_argument);
+
+        std::string blob = accumulator.serialize();
+        REQUIRE_THROWS_AS(descriptiveStatistics::CovarianceAccumulator::deserialize(blob.substr(0, blob.size() - 1)), std::runtime_error);
+        REQUIRE_THROWS_AS(descriptiveStatistics::CovarianceAccumulator::deserialize("not a blob"), std::runtime_error);
+    }
+}
+
 TEST_CASE("Empty Input", "[descriptiveStatistics]") {
 
     DataFrame df;
@@ -138,3 +219,161 @@ TEST_CASE("Empty Input", "[descriptiveStatistics]") {
 }
 
 
+
+TEST_CASE("Column summaries in a single pass", "[descriptiveStatistics][describe]") {
+
+    SECTION("Count, mean, variance, min and max for all column types") {
+        DataFrame df({{"I", {3, -1, 4, 1}}, {"F", {0.5, 1.5, 2.5, 3.5}}, {"D", {2, 2, 2, 2}}}, {},
+                     {ColumnType::Int, ColumnType::Float, ColumnType::Double});
+        std::vector<descriptiveStatistics::ColumnSummary> summaries = descriptiveStatistics::describe(df);
+        REQUIRE(summaries.size() == 3);
+        REQUIRE(summaries[0].count == 4);
+        REQUIRE(summaries[0].mean == 1.75);
+        REQUIRE(summaries[0].min == -1.0);
+        REQUIRE(summaries[0].max == 4.0);
+        REQUIRE(summaries[0].variance() == Approx(14.75 / 3.0));
+        REQUIRE(summaries[1].mean == 2.0);
+        REQUIRE(summaries[1].standardDeviation() == Approx(std::sqrt(5.0 / 3.0)));
+        REQUIRE(summaries[2].variance() == 0.0);
+    }
+
+    SECTION("Merged summaries equal the summary of all values") {
+        std::vector<double> values;
+        for (int i = 0; i < 10000; ++i) values.push_back(std::sin(i) * 100 + i * 0.01);
+        descriptiveStatistics::ColumnSummary first, second, added;
+        for (int i = 0; i < 10000; ++i) {
+            (i < 3000 ? first : second).add(values[i]);
+            added.add(values[i]);
+        }
+        first.merge(second);
+
+        Column col(ColumnType::Double);
+        col.fillFromDouble(values);
+        descriptiveStatistics::ColumnSummary summary = descriptiveStatistics::summarize(col);
+        for (const auto& other : {first, added}) {
+            REQUIRE(other.count == summary.count);
+            REQUIRE(other.mean == Approx(summary.mean).epsilon(1e-12));
+            REQUIRE(other.m2 == Approx(summary.m2).epsilon(1e-12));
+            REQUIRE(other.min == summary.min);
+            REQUIRE(other.max == summary.max);
+        }
+    }
+
+    SECTION("Stable for values with a large offset") {
+        std::vector<double> values;
+        for (int i = 0; i < 100000; ++i) values.push_back(1e9 + (i % 2 == 0 ? 1.0 : -1.0));
+        DataFrame df({{"A", values}});
+        REQUIRE(descriptiveStatistics::variances(df)[0] == Approx(100000.0 / 99999.0).epsilon(1e-9));
+    }
+
+    SECTION("Empty and single value columns") {
+        DataFrame df({{"A", {1.0}}});
+        descriptiveStatistics::ColumnSummary summary = descriptiveStatistics::describe(df)[0];
+        REQUIRE(summary.mean == 1.0);
+        REQUIRE(std::isnan(summary.variance()));
+        REQUIRE(descriptiveStatistics::describe(DataFrame()).empty());
+    }
+}
+
+TEST_CASE("Correlation matrix calculation", "[descriptiveStatistics][correlations]") {
+    DataFrame iris = csvHandler::fromCSV("../../Data/Iris.txt");
+    // Correlation of the Iris data set calculated in R
+    Eigen::MatrixXd expected(4, 4);
+    expected << 1.0, -0.1175698, 0.8717538, 0.8179411,
+                -0.1175698, 1.0, -0.4284401, -0.3661259,
+                0.8717538, -0.4284401, 1.0, 0.9628654,
+                0.8179411, -0.3661259, 0.9628654, 1.0;
+
+    SECTION("Scaled covariance matrix") {
+        Eigen::MatrixXd corr = descriptiveStatistics::correlationsEigen(iris);
+        REQUIRE(corr.isApprox(expected, 1e-6));
+        DataFrame dfCorr = descriptiveStatistics::correlations(iris);
+        REQUIRE(dfCorr.get("petal.width", "petal.length") == Approx(0.9628654));
+        REQUIRE(dfCorr.getRowNames() == iris.getColNames());
+    }
+
+    SECTION("Pairwise complete without missing values") {
+        REQUIRE(descriptiveStatistics::correlationsEigen(iris, true).isApprox(expected, 1e-6));
+    }
+
+    SECTION("Pairwise complete skips NaN per pair") {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        DataFrame df({
+            {"A", {1, 2, 3, 4, nan, 6}},
+            {"B", {2, 4, 6, nan, 10, 11}},
+            {"C", {1e9 + 1, 1e9 + 3, 1e9 + 2, 1e9 + 5, 1e9 + 4, nan}},
+            {"D", {nan, nan, nan, nan, 1, 2}}
+        });
+        Eigen::MatrixXd corr = descriptiveStatistics::correlationsEigen(df, true);
+
+        // Reference from the complete rows of every pair
+        auto reference = [&](int i, int j) {
+            std::vector<std::pair<std::string, std::vector<double>>> cols = {{"X", {}}, {"Y", {}}};
+            for (int row = 0; row < 6; ++row) {
+                double x = df.get(row, i), y = df.get(row, j);
+                if (std::isnan(x) || std::isnan(y)) continue;
+                cols[0].second.push_back(x);
+                cols[1].second.push_back(y);
+            }
+            DataFrame complete(cols);
+            return descriptiveStatistics::correlationsEigen(complete)(0, 1);
+        };
+        REQUIRE(corr(0, 1) == Approx(reference(0, 1)));
+        REQUIRE(corr(0, 2) == Approx(reference(0, 2)));
+        REQUIRE(corr(2, 1) == Approx(reference(1, 2)));
+        REQUIRE(corr(1, 1) == 1.0);
+        REQUIRE(std::isnan(corr(0, 3)));
+        REQUIRE(std::isnan(corr(2, 3)));
+
+        REQUIRE(std::isnan(descriptiveStatistics::correlationsEigen(df)(0, 1)));
+    }
+
+    SECTION("Constant columns and empty input") {
+        DataFrame df({{"A", {1, 2, 3}}, {"B", {5, 5, 5}}});
+        REQUIRE(std::isnan(descriptiveStatistics::correlationsEigen(df)(0, 1)));
+        REQUIRE(std::isnan(descriptiveStatistics::correlationsEigen(df, true)(0, 1)));
+        DataFrame empty;
+        REQUIRE_THROWS_AS(descriptiveStatistics::correlations(empty), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Memoized statistics are invalidated by modifications", "[descriptiveStatistics][cache]") {
+    DataFrame df({
+        {"A", {1.0, 2.0, 3.0, 4.0}},
+        {"B", {5.0, 5.0, 5.0, 5.0}}
+    });
+    REQUIRE(descriptiveStatistics::means(df) == std::vector<double>{2.5, 5.0});
+    REQUIRE(descriptiveStatistics::constantColumns(df) == std::vector<bool>{false, true});
+    Eigen::MatrixXd cov = descriptiveStatistics::covariancesEigen(df);
+    REQUIRE(descriptiveStatistics::covariancesEigen(df) == cov);
+
+    SECTION("set") {
+        df.set(9.0, 0, "B");
+        REQUIRE(descriptiveStatistics::means(df) == std::vector<double>{2.5, 6.0});
+        REQUIRE(descriptiveStatistics::constantColumns(df) == std::vector<bool>{false, false});
+        REQUIRE(descriptiveStatistics::covariancesEigen(df)(1, 1) == Approx(4.0));
+        REQUIRE(descriptiveStatistics::covariancesEigen(df)(0, 1) == Approx(-2.0));
+    }
+
+    SECTION("addRow and dropRow") {
+        std::vector<double> row = {10.0, 5.0};
+        df.addRow(row);
+        REQUIRE(descriptiveStatistics::describe(df)[0].count == 5);
+        REQUIRE(descriptiveStatistics::means(df)[0] == Approx(4.0));
+        df.dropRow(4);
+        df.dropRow(0);
+        REQUIRE(descriptiveStatistics::means(df)[0] == Approx(3.0));
+        REQUIRE(descriptiveStatistics::describe(df)[0].max == 4.0);
+        REQUIRE(descriptiveStatistics::covariancesEigen(df)(0, 0) == Approx(1.0));
+    }
+
+    SECTION("Copies and dropped columns") {
+        DataFrame copy = df;
+        copy.set(0.0, 3, "A");
+        REQUIRE(descriptiveStatistics::means(copy)[0] == Approx(1.5));
+        REQUIRE(descriptiveStatistics::means(df)[0] == Approx(2.5));
+        copy.dropColumn(0);
+        REQUIRE(descriptiveStatistics::means(copy) == std::vector<double>{5.0});
+        REQUIRE(descriptiveStatistics::covariancesEigen(copy).size() == 1);
+    }
+}
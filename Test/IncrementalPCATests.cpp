@@ -0,0 +1,101 @@
+#include "catch2/catch.hpp"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "DataFrame.hpp"
+#include "CsvHandler.hpp"
+#include "CastingHelper.hpp"
+#include "PCA.hpp"
+#include "IncrementalPCA.hpp"
+
+
+namespace {
+    // Splits the rows of a DataFrame into batches of the given size
+    std::vector<DataFrame> splitRows(DataFrame& df, int batchSize) {
+        std::vector<std::string> cols = df.getColNames();
+        std::vector<DataFrame> batches;
+        for (int begin = 0; begin < df.getDim().first; begin += batchSize) {
+            std::vector<int> rows;
+            for (int row = begin; row < std::min(df.getDim().first, begin + batchSize); ++row) rows.push_back(row);
+            batches.push_back(df.get(std::span<int>(rows), std::span<std::string>(cols)));
+        }
+        return batches;
+    }
+}
+
+
+TEST_CASE("IncrementalPCA with all components matches PCA", "[IncrementalPCA]") {
+    DataFrame df = csvHandler::fromCSV("../../Data/Iris.txt");
+    PCA pca;
+    pca.fit(df);
+
+    // Batches of different sizes, the last one is smaller
+    for (int batchSize : {150, 40, 7}) {
+        IncrementalPCA ipca(4);
+        for (DataFrame& batch : splitRows(df, batchSize)) ipca.partialFit(batch);
+        REQUIRE(ipca.getCount() == 150);
+
+        std::vector<double> eigenvalues = ipca.getEigenvalues();
+        std::vector<double> eigenvaluesExpected = pca.getEigenvalues();
+        std::vector<std::vector<double>> eigenvectors = ipca.getEigenvectors();
+        std::vector<std::vector<double>> eigenvectorsExpected = pca.getEigenvectors();
+        for (int comp = 0; comp < 4; ++comp) {
+            REQUIRE(eigenvalues[comp] == Approx(eigenvaluesExpected[comp]).epsilon(1e-9));
+            double sign = eigenvectors[comp][0] * eigenvectorsExpected[comp][0] < 0 ? -1.0 : 1.0;
+            for (int col = 0; col < 4; ++col) {
+                REQUIRE(sign * eigenvectors[comp][col] == Approx(eigenvectorsExpected[comp][col]).margin(1e-8));
+            }
+        }
+        std::vector<double> means = ipca.getMeans();
+        REQUIRE(means[0] == Approx(5.843333));
+    }
+}
+
+TEST_CASE("IncrementalPCA keeps the top components of low rank data", "[IncrementalPCA]") {
+    // Data of rank 2, so two components describe it exactly
+    const int n = 600, p = 12;
+    std::mt19937 random(3);
+    std::normal_distribution<double> normal;
+    Eigen::MatrixXd factors(n, 2), loadings(2, p);
+    for (int i = 0; i < n; ++i) for (int r = 0; r < 2; ++r) factors(i, r) = normal(random) * (r == 0 ? 5.0 : 1.0);
+    for (int r = 0; r < 2; ++r) for (int j = 0; j < p; ++j) loadings(r, j) = normal(random);
+    Eigen::MatrixXd data = factors * loadings;
+    data.rowwise() += Eigen::RowVectorXd::LinSpaced(p, 1.0, 100.0);
+    DataFrame df = castingHelper::eigenMatrixToDataFrame(data);
+
+    PCA pca;
+    pca.fit(df);
+    IncrementalPCA ipca(2);
+    for (DataFrame& batch : splitRows(df, 64)) ipca.partialFit(batch);
+
+    std::vector<double> eigenvalues = ipca.getEigenvalues();
+    REQUIRE(eigenvalues.size() == 2);
+    REQUIRE(eigenvalues[0] == Approx(pca.getEigenvalues()[0]).epsilon(1e-9));
+    REQUIRE(eigenvalues[1] == Approx(pca.getEigenvalues()[1]).epsilon(1e-9));
+
+    // The scores are the centered projections, which agree with the PCA scores up to the sign and the (uncentered) offset of PCA
+    DataFrame scores = ipca.transform(df, 2);
+    DataFrame scoresPca = pca.transform(df, 2);
+    REQUIRE(scores.getDim() == std::make_pair(n, 2));
+    for (int comp = 0; comp < 2; ++comp) {
+        double meanPca = descriptiveStatistics::means(scoresPca)[comp];
+        for (int row = 0; row < 20; ++row) {
+            REQUIRE(std::abs(scores.get(row, comp)) == Approx(std::abs(scoresPca.get(row, comp) - meanPca)).epsilon(1e-6));
+        }
+    }
+    REQUIRE(ipca.getEigenInformation().getDim() == std::make_pair(p, 2));
+
+    SECTION("Invalid input") {
+        REQUIRE_THROWS_AS(IncrementalPCA(0), std::invalid_argument);
+        IncrementalPCA unfitted(2);
+        REQUIRE_THROWS_AS(unfitted.transform(df), std::runtime_error);
+        DataFrame other({{"A", {1.0, 2.0}}, {"B", {2.0, 1.0}}});
+        REQUIRE_THROWS_AS(ipca.partialFit(other), std::invalid_argument);
+        DataFrame empty;
+        REQUIRE_THROWS_AS(unfitted.partialFit(empty), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipca.transform(df, 0), std::invalid_argument);
+    }
+}
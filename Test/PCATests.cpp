@@ -2,6 +2,7 @@
 #include "catch2/catch.hpp"
 
 #include <cmath>
+#include <random>
 
 #include "DataFrame.hpp"
 #include "Column.hpp"
@@ -112,14 +113,14 @@ TEST_CASE("PCA fit check eigenvalues and eigenvectors", "[PCA]") {
 
     PCA pca;
 
-    SECTION("SVD is false") {
-        pca.fit(df, false, false, true);
+    SECTION("Covariance eigensolver") {
+        pca.fit(df, false, PcaSolver::CovarianceEigen, true);
         checkAfterNormalizing(pca, eigenvaluesExpected, expectedEigenvectors);
     }
 
-    SECTION("SVD is true") {
+    SECTION("Jacobi SVD") {
         // In this case it should still be the Eigendecomposition be used, since we have a Covariance-Matrix!
-        pca.fit(df, false, true, true);
+        pca.fit(df, false, PcaSolver::Jacobi, true);
         checkAfterNormalizing(pca, eigenvaluesExpected, expectedEigenvectors);
     }
 
@@ -141,17 +142,23 @@ TEST_CASE("PCA fit check eigenvalues and eigenvectors on Iris, with automatic Sc
 
     PCA pca;
 
-    SECTION("SVD is false") {
-        pca.fit(df, true, false, false);
+    SECTION("Covariance eigensolver") {
+        pca.fit(df, true, PcaSolver::CovarianceEigen, false);
         checkAfterNormalizing(pca, eigenvaluesExpected, expectedEigenvectors);
     }
 
-    SECTION("SVD is true") {
-        // In this case it should still be the Eigendecomposition be used, since we have a Covariance-Matrix!
-        pca.fit(df, true, true, false);
+    SECTION("Jacobi SVD") {
+        pca.fit(df, true, PcaSolver::Jacobi, false);
         checkAfterNormalizing(pca, eigenvaluesExpected, expectedEigenvectors);
     }
 
+    SECTION("Other solvers") {
+        for (PcaSolver solver : {PcaSolver::Auto, PcaSolver::BDC, PcaSolver::Randomized, PcaSolver::Lanczos}) {
+            pca.fit(df, true, solver);
+            checkAfterNormalizing(pca, eigenvaluesExpected, expectedEigenvectors);
+        }
+    }
+
 }
 
 TEST_CASE("PCA transform throw exception when dim is 0", "[PCA]") {
@@ -166,7 +173,7 @@ TEST_CASE("PCA transform throw exception when dim is 0", "[PCA]") {
     DataFrame df(cols, rowNames);
 
     PCA pca;
-    pca.fit(df, false, false, true);
+    pca.fit(df, false, PcaSolver::CovarianceEigen, true);
     REQUIRE_THROWS_AS(pca.transform(df, 0), std::invalid_argument);
 }
 
@@ -218,8 +225,8 @@ TEST_CASE("PCA transform", "[PCA]") {
 
     PCA pca;
 
-    SECTION("SVD is false") {
-        pca.fit(df, true, false);
+    SECTION("Covariance eigensolver") {
+        pca.fit(df, true, PcaSolver::CovarianceEigen);
         DataFrame proj = pca.transform(df);
 
         REQUIRE(proj.getDim().first == 150);
@@ -232,8 +239,8 @@ TEST_CASE("PCA transform", "[PCA]") {
         }
     }
 
-    SECTION("SVD is true") {
-        pca.fit(df, true, true);
+    SECTION("Jacobi SVD") {
+        pca.fit(df, true, PcaSolver::Jacobi);
         DataFrame proj = pca.transform(df);
 
         REQUIRE(proj.getDim().first == 150);
@@ -259,3 +266,129 @@ TEST_CASE("PCA transform without fit", "[PCA]") {
     REQUIRE_THROWS_AS(pca.transform(df), std::runtime_error);
 }
 
+
+TEST_CASE("PCA folds the normalization into the projection", "[PCA]") {
+    DataFrame df({
+        {"A", {1.0, 4.0, 2.0, 8.0, 5.0, 7.0}},
+        {"B", {10.0, 30.0, 20.0, 70.0, 40.0, 50.0}},
+        {"C", {3.0, 1.0, 2.0, 0.0, 1.0, 5.0}}
+    }, {}, {ColumnType::Double, ColumnType::Float, ColumnType::Int});
+
+    for (PcaSolver solver : {PcaSolver::CovarianceEigen, PcaSolver::Jacobi, PcaSolver::BDC}) {
+        PCA pca;
+        pca.fit(df, true, solver);
+        DataFrame proj = pca.transform(df, 3);
+
+        // Reference: Normalize the data first, then project it onto the eigenvectors
+        StandardScaler scaler;
+        DataFrame scaled = scaler.fitTransform(df);
+        Eigen::MatrixXd scaledMat = castingHelper::dataFrameToEigenMatrix(scaled);
+        std::vector<std::vector<double>> eigenvectors = pca.getEigenvectors();
+        for (int comp = 0; comp < 3; ++comp) {
+            Eigen::VectorXd expected = scaledMat * Eigen::Map<Eigen::VectorXd>(eigenvectors[comp].data(), 3);
+            for (int row = 0; row < 6; ++row) {
+                REQUIRE(proj.get(row, comp) == Approx(expected(row)).margin(1e-10));
+            }
+        }
+
+        // The eigenvalues of the correlation matrix sum up to the number of variables
+        std::vector<double> eigenvalues = pca.getEigenvalues();
+        REQUIRE(eigenvalues[0] + eigenvalues[1] + eigenvalues[2] == Approx(3.0));
+    }
+}
+
+TEST_CASE("Randomized PCA approximates the top components", "[PCA][randomized]") {
+    // Low rank data with a decaying spectrum plus noise
+    const int n = 2000, p = 40, rank = 6;
+    std::mt19937 random(7);
+    std::normal_distribution<double> normal;
+    Eigen::MatrixXd factors(n, rank), loadings(rank, p);
+    for (int i = 0; i < n; ++i) for (int r = 0; r < rank; ++r) factors(i, r) = normal(random) * std::pow(2.0, rank - r);
+    for (int r = 0; r < rank; ++r) for (int j = 0; j < p; ++j) loadings(r, j) = normal(random);
+    Eigen::MatrixXd data = factors * loadings;
+    for (int i = 0; i < n; ++i) for (int j = 0; j < p; ++j) data(i, j) += 0.1 * normal(random) + j;
+    DataFrame df = castingHelper::eigenMatrixToDataFrame(data);
+
+    for (bool centerAndScale : {false, true}) {
+        PCA exact, randomized;
+        exact.fit(df, centerAndScale);
+        randomized.fitRandomized(df, 4, centerAndScale);
+
+        std::vector<double> eigenvaluesExact = exact.getEigenvalues();
+        std::vector<double> eigenvalues = randomized.getEigenvalues();
+        std::vector<std::vector<double>> eigenvectorsExact = exact.getEigenvectors();
+        std::vector<std::vector<double>> eigenvectors = randomized.getEigenvectors();
+        REQUIRE(eigenvalues.size() == 4);
+
+        for (int comp = 0; comp < 4; ++comp) {
+            // Relative error of the eigenvalue and angle between the eigenvectors (up to the sign)
+            double valueError = std::abs(eigenvalues[comp] - eigenvaluesExact[comp]) / eigenvaluesExact[comp];
+            double cosine = std::abs(Eigen::Map<Eigen::VectorXd>(eigenvectors[comp].data(), p).dot(
+                                     Eigen::Map<Eigen::VectorXd>(eigenvectorsExact[comp].data(), p)));
+            INFO("Component " << comp << ": relative eigenvalue error " << valueError << ", 1 - |cos| " << 1 - cosine);
+            REQUIRE(valueError < 1e-8);
+            REQUIRE(1 - cosine < 1e-8);
+        }
+
+        // The scores agree up to the sign as well
+        DataFrame scoresExact = exact.transform(df, 2);
+        DataFrame scores = randomized.transform(df, 2);
+        for (int row = 0; row < 10; ++row) {
+            REQUIRE(std::abs(scores.get(row, 0)) == Approx(std::abs(scoresExact.get(row, 0))).epsilon(1e-6));
+        }
+    }
+
+    SECTION("Invalid number of components") {
+        PCA pca;
+        REQUIRE_THROWS_AS(pca.fitRandomized(df, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(pca.fitRandomized(df, p + 1), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Lanczos method finds the largest eigenpairs", "[PCA][LinAlgOps]") {
+    const int p = 60;
+    std::mt19937 random(11);
+    std::normal_distribution<double> normal;
+    Eigen::MatrixXd data(200, p);
+    for (int i = 0; i < data.rows(); ++i) for (int j = 0; j < p; ++j) data(i, j) = normal(random) * (j % 5 + 1);
+    Eigen::MatrixXd symMat = data.transpose() * data;
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> exact(symMat);
+    for (int k : {1, 5, p}) {
+        auto [eigenvalues, eigenvectors] = linAlgOps::lanczosEigen(symMat, k);
+        REQUIRE(eigenvalues.size() == k);
+        for (int i = 0; i < k; ++i) {
+            const int exactIndex = p - k + i;
+            REQUIRE(eigenvalues(i) == Approx(exact.eigenvalues()(exactIndex)).epsilon(1e-9));
+            REQUIRE(std::abs(eigenvectors.col(i).dot(exact.eigenvectors().col(exactIndex))) == Approx(1.0).epsilon(1e-6));
+        }
+    }
+
+    // Rank 3: the Krylov subspace becomes invariant and is restarted
+    Eigen::MatrixXd lowRank = data.leftCols(3) * data.leftCols(3).transpose();
+    auto [eigenvalues, eigenvectors] = linAlgOps::lanczosEigen(lowRank.topLeftCorner(50, 50), 5);
+    REQUIRE(eigenvalues.size() == 5);
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> exactLowRank(lowRank.topLeftCorner(50, 50));
+    REQUIRE(eigenvalues(4) == Approx(exactLowRank.eigenvalues()(49)).epsilon(1e-9));
+
+    REQUIRE_THROWS_AS(linAlgOps::lanczosEigen(symMat, 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(linAlgOps::lanczosEigen(data, 2), std::invalid_argument);
+}
+
+TEST_CASE("PCA solver selection", "[PCA]") {
+    // Few rows and many variables, few components of many or of fewer variables, and all components
+    REQUIRE(PCA::chooseSolver(100, 2000, 0, false) == PcaSolver::BDC);
+    REQUIRE(PCA::chooseSolver(100000, 1000, 10, false) == PcaSolver::Randomized);
+    REQUIRE(PCA::chooseSolver(100000, 200, 10, false) == PcaSolver::Lanczos);
+    REQUIRE(PCA::chooseSolver(100000, 50, 10, false) == PcaSolver::CovarianceEigen);
+    REQUIRE(PCA::chooseSolver(100000, 1000, 0, false) == PcaSolver::CovarianceEigen);
+    REQUIRE(PCA::chooseSolver(1000, 1000, 10, true) == PcaSolver::Lanczos);
+    REQUIRE(PCA::chooseSolver(4, 4, 0, true) == PcaSolver::CovarianceEigen);
+
+    // Only the requested number of components is kept
+    DataFrame df = csvHandler::fromCSV("../../Data/Iris.txt");
+    PCA pca;
+    pca.fit(df, true, PcaSolver::Auto, false, 2);
+    REQUIRE(pca.getEigenvalues().size() == 2);
+    REQUIRE_THROWS_AS(pca.fit(df, true, PcaSolver::Auto, false, 5), std::invalid_argument);
+}
@@ -0,0 +1,84 @@
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "DataFrame.hpp"
+#include "CsvHandler.hpp"
+#include "DescriptiveStatistics.hpp"
+#include "QuantileSketch.hpp"
+
+
+TEST_CASE("QuantileSketch is exact for small inputs", "[QuantileSketch]") {
+    descriptiveStatistics::QuantileSketch sketch;
+    for (int i = 10; i >= 1; --i) sketch.add(i);
+    sketch.add(std::numeric_limits<double>::quiet_NaN());
+
+    REQUIRE(sketch.isExact());
+    REQUIRE(sketch.getCount() == 10);
+    REQUIRE(sketch.quantile(0.0) == 1.0);
+    REQUIRE(sketch.quantile(0.25) == Approx(3.25));
+    REQUIRE(sketch.median() == Approx(5.5));
+    REQUIRE(sketch.quantile(1.0) == 10.0);
+
+    SECTION("Invalid input") {
+        REQUIRE_THROWS_AS(sketch.quantile(1.5), std::invalid_argument);
+        REQUIRE_THROWS_AS(descriptiveStatistics::QuantileSketch().median(), std::invalid_argument);
+        REQUIRE_THROWS_AS(descriptiveStatistics::QuantileSketch(4), std::invalid_argument);
+    }
+}
+
+TEST_CASE("QuantileSketch approximates quantiles of large inputs in bounded memory", "[QuantileSketch]") {
+    const int n = 300000;
+    std::vector<double> values(n);
+    for (int i = 0; i < n; ++i) values[i] = i;
+    std::shuffle(values.begin(), values.end(), std::mt19937(42));
+
+    descriptiveStatistics::QuantileSketch single;
+    std::vector<descriptiveStatistics::QuantileSketch> parts(4);
+    for (int i = 0; i < n; ++i) {
+        single.add(values[i]);
+        parts[i % 4].add(values[i]);
+    }
+    for (int i = 1; i < 4; ++i) parts[0].merge(parts[i]);
+
+    for (const auto& sketch : {single, parts[0]}) {
+        REQUIRE_FALSE(sketch.isExact());
+        REQUIRE(sketch.getCount() == n);
+        REQUIRE(sketch.getMin() == 0.0);
+        REQUIRE(sketch.getMax() == n - 1.0);
+        for (double q : {0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99}) {
+            REQUIRE(std::abs(sketch.quantile(q) - q * n) < 0.02 * n);
+        }
+    }
+
+    SECTION("Exact limit") {
+        descriptiveStatistics::QuantileSketch exact(200, n);
+        exact.add(std::span<const double>(values));
+        REQUIRE(exact.isExact());
+        REQUIRE(exact.median() == Approx(149999.5));
+    }
+}
+
+TEST_CASE("Quantiles of DataFrame columns", "[QuantileSketch][descriptiveStatistics]") {
+    DataFrame iris = csvHandler::fromCSV("../../Data/Iris.txt");
+    // Medians of the Iris data set calculated in R
+    std::vector<double> mediansExpected = {5.8, 3.0, 4.35, 1.3};
+
+    std::vector<descriptiveStatistics::QuantileSketch> sketches;
+    std::vector<descriptiveStatistics::ColumnSummary> summaries = descriptiveStatistics::describe(iris, sketches, 200, 1000);
+    REQUIRE(sketches.size() == 4);
+    std::vector<double> medians = descriptiveStatistics::quantiles(iris, 0.5);
+    for (int col = 0; col < 4; ++col) {
+        REQUIRE(sketches[col].getCount() == summaries[col].count);
+        REQUIRE(sketches[col].median() == Approx(mediansExpected[col]));
+        REQUIRE(medians[col] == Approx(mediansExpected[col]));
+    }
+
+    DataFrame empty;
+    REQUIRE_THROWS_AS(descriptiveStatistics::quantiles(empty, 0.5), std::invalid_argument);
+}
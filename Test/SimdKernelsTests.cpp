@@ -0,0 +1,81 @@
+#include "catch2/catch.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "SimdKernels.hpp"
+
+
+namespace {
+    // Compares the kernels of every instruction set supported by the CPU with the scalar kernels
+    template<typename T>
+    void compareWithScalar(const std::vector<T>& a, const std::vector<T>& b) {
+        std::span<const T> spanA(a), spanB(b);
+        simdKernels::SimdLevel detected = simdKernels::detectSimdLevel();
+
+        simdKernels::setSimdLevel(simdKernels::SimdLevel::Scalar);
+        double sum = simdKernels::sum(spanA);
+        double squares = simdKernels::sumSquaredDeviations(spanA, 1.5);
+        double dot = simdKernels::dot(spanA, spanB);
+        simdKernels::MinMax minMax = simdKernels::minMax(spanA);
+        std::vector<double> standardized(a.size()), standardizedSimd(a.size());
+        simdKernels::standardize(spanA, 1.5, 0.25, std::span<double>(standardized));
+
+        for (simdKernels::SimdLevel level : {simdKernels::SimdLevel::AVX2, simdKernels::SimdLevel::AVX512}) {
+            if (static_cast<int>(level) > static_cast<int>(detected)) continue;
+            simdKernels::setSimdLevel(level);
+            REQUIRE(simdKernels::sum(spanA) == Approx(sum).epsilon(1e-12));
+            REQUIRE(simdKernels::sumSquaredDeviations(spanA, 1.5) == Approx(squares).epsilon(1e-12));
+            REQUIRE(simdKernels::dot(spanA, spanB) == Approx(dot).epsilon(1e-12));
+            REQUIRE(simdKernels::minMax(spanA).min == minMax.min);
+            REQUIRE(simdKernels::minMax(spanA).max == minMax.max);
+            simdKernels::standardize(spanA, 1.5, 0.25, std::span<double>(standardizedSimd));
+            REQUIRE(standardizedSimd == standardized);
+        }
+        simdKernels::setSimdLevel(detected);
+    }
+}
+
+
+TEST_CASE("SIMD kernels match the scalar kernels", "[simdKernels]") {
+    // Lengths around the vector widths and the unrolled loops test the tails
+    for (int n : {1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 100, 1001}) {
+        std::vector<int> ints(n), intsB(n);
+        std::vector<float> floats(n), floatsB(n);
+        std::vector<double> doubles(n), doublesB(n);
+        for (int i = 0; i < n; ++i) {
+            ints[i] = (i * 7919) % 1000 - 500;
+            intsB[i] = (i * 104729) % 300 - 150;
+            floats[i] = static_cast<float>(std::sin(i) * 100);
+            floatsB[i] = static_cast<float>(std::cos(i));
+            doubles[i] = std::sin(i * 0.3) * 1e6;
+            doublesB[i] = std::cos(i * 0.7);
+        }
+        compareWithScalar(ints, intsB);
+        compareWithScalar(floats, floatsB);
+        compareWithScalar(doubles, doublesB);
+    }
+}
+
+TEST_CASE("SIMD kernels calculate exact results for small integers", "[simdKernels]") {
+    std::vector<int> values = {3, -1, 4, 1, 5, -9, 2, 6, 5, 3, -5, 8, 9, 7, 9, 3, 2};
+    std::span<const int> span(values);
+    REQUIRE(simdKernels::sum(span) == 52.0);
+    REQUIRE(simdKernels::minMax(span).min == -9.0);
+    REQUIRE(simdKernels::minMax(span).max == 9.0);
+    REQUIRE(simdKernels::dot(span, span) == 520.0);
+    REQUIRE(simdKernels::sumSquaredDeviations(span, 0.0) == 520.0);
+
+    REQUIRE_THROWS_AS(simdKernels::minMax(std::span<const int>()), std::invalid_argument);
+    REQUIRE_THROWS_AS(simdKernels::dot(span, span.first(3)), std::invalid_argument);
+}
+
+TEST_CASE("Standardize works in place and checks the lengths", "[simdKernels]") {
+    std::vector<double> values = {1.0, 3.0, 5.0, 7.0, 9.0, 11.0, 13.0, 15.0, 17.0, 19.0, 21.0};
+    simdKernels::standardize(std::span<const double>(values), 11.0, 0.5, std::span<double>(values));
+    REQUIRE(values == std::vector<double>{-5.0, -4.0, -3.0, -2.0, -1.0, 0.0, 1.0, 2.0, 3.0, 4.0, 5.0});
+
+    std::vector<double> out(3);
+    REQUIRE_THROWS_AS(simdKernels::standardize(std::span<const double>(values), 0.0, 1.0, std::span<double>(out)), std::invalid_argument);
+}
@@ -1,6 +1,8 @@
 
 #include "catch2/catch.hpp"
 
+#include <cmath>
+
 #include "DataFrame.hpp"
 #include "Column.hpp"
 #include "DescriptiveStatistics.hpp"
@@ -72,3 +74,92 @@ TEST_CASE("StandardScaler transform without fit", "[StandardScaler]") {
     StandardScaler scaler;
     REQUIRE_THROWS_AS(scaler.transform(df), std::runtime_error);
 }
+
+TEST_CASE("StandardScaler transforms in place and into preallocated DataFrames", "[StandardScaler]") {
+    DataFrame df({
+        {"A", {1.0, 2.0, 3.0, 4.0}},
+        {"B", {4.0, 8.0, 6.0, 2.0}},
+        {"C", {1.0, 0.0, 1.0, 0.0}}
+    }, {}, {ColumnType::Double, ColumnType::Float, ColumnType::Int});
+    StandardScaler scaler;
+    DataFrame expected = scaler.fitTransform(df);
+
+    auto requireScaled = [&](DataFrame& result) {
+        REQUIRE(result.getDim() == expected.getDim());
+        REQUIRE(result.getColNames() == expected.getColNames());
+        for (int col = 0; col < 3; ++col) {
+            REQUIRE(result.getColumnType(col) == ColumnType::Double);
+            for (int row = 0; row < 4; ++row) {
+                REQUIRE(result.get(row, col) == Approx(expected.get(row, col)));
+            }
+        }
+    };
+
+    SECTION("transformInPlace") {
+        DataFrame copy = df;
+        scaler.transformInPlace(copy);
+        requireScaled(copy);
+        REQUIRE(df.get(0, "A") == 1.0);
+        REQUIRE(df.getColumnType(2) == ColumnType::Int);
+    }
+
+    SECTION("transformInto reuses the buffers of the output") {
+        DataFrame out;
+        scaler.transformInto(df, out);
+        requireScaled(out);
+
+        const double* buffer = out.getColumn(0).getSpan<double>().data();
+        std::uint64_t version = out.getVersion();
+        scaler.transformInto(df, out);
+        requireScaled(out);
+        REQUIRE(out.getColumn(0).getSpan<double>().data() == buffer);
+        REQUIRE(out.getVersion() != version);
+    }
+
+    SECTION("transformInto replaces an output with another layout") {
+        DataFrame out({{"X", {1.0}}});
+        scaler.transformInto(df, out);
+        requireScaled(out);
+    }
+}
+
+TEST_CASE("StandardScaler partialFit and merge match a full fit", "[StandardScaler]") {
+    std::vector<double> a, b;
+    for (int i = 0; i < 100; ++i) {
+        a.push_back(1e6 + std::sin(i) * 10);
+        b.push_back(i % 7);
+    }
+    DataFrame all({{"A", a}, {"B", b}});
+    StandardScaler full;
+    full.fit(all);
+
+    // Batches of different sizes
+    std::vector<int> bounds = {0, 10, 55, 100};
+    std::vector<StandardScaler> shards(3);
+    StandardScaler streaming;
+    std::vector<std::string> cols = {"A", "B"};
+    for (int i = 0; i < 3; ++i) {
+        std::vector<int> rows;
+        for (int row = bounds[i]; row < bounds[i + 1]; ++row) rows.push_back(row);
+        DataFrame batch = all.get(std::span<int>(rows), std::span<std::string>(cols));
+        streaming.partialFit(batch);
+        shards[i].fit(batch);
+    }
+    StandardScaler merged;
+    for (const StandardScaler& shard : shards) merged.merge(shard);
+
+    for (StandardScaler* scaler : {&streaming, &merged}) {
+        for (int col = 0; col < 2; ++col) {
+            REQUIRE(scaler->getMeans()[col] == Approx(full.getMeans()[col]).epsilon(1e-12));
+            REQUIRE(scaler->getStdevs()[col] == Approx(full.getStdevs()[col]).epsilon(1e-10));
+        }
+    }
+
+    SECTION("Batches with other columns are rejected") {
+        DataFrame other({{"A", {1.0, 2.0}}});
+        REQUIRE_THROWS_AS(streaming.partialFit(other), std::invalid_argument);
+        StandardScaler otherScaler;
+        otherScaler.fit(other);
+        REQUIRE_THROWS_AS(merged.merge(otherScaler), std::invalid_argument);
+    }
+}
@@ -0,0 +1,79 @@
+#include "catch2/catch.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "ThreadPool.hpp"
+#include "DataFrame.hpp"
+#include "DescriptiveStatistics.hpp"
+#include "StandardScaler.hpp"
+
+
+TEST_CASE("ThreadPool runs every task once", "[ThreadPool]") {
+    ThreadPool pool(4);
+    REQUIRE(pool.getNumThreads() == 4);
+
+    SECTION("All indices") {
+        std::vector<std::atomic<int>> calls(1000);
+        pool.parallelFor(1000, [&](int i) { calls[i]++; });
+        for (auto& count : calls) {
+            REQUIRE(count == 1);
+        }
+    }
+
+    SECTION("Nested parallelFor") {
+        std::atomic<int> sum{0};
+        pool.parallelFor(8, [&](int i) {
+            pool.parallelFor(10, [&](int j) { sum += i * 10 + j; });
+        });
+        REQUIRE(sum == 79 * 80 / 2);
+    }
+
+    SECTION("The exception of the lowest index is rethrown after all tasks are finished") {
+        std::atomic<int> finished{0};
+        try {
+            pool.parallelFor(100, [&](int i) {
+                if (i == 30 || i == 70) throw std::runtime_error("Task " + std::to_string(i));
+                finished++;
+            });
+            FAIL("No exception thrown");
+        } catch (const std::runtime_error& e) {
+            REQUIRE(std::string(e.what()) == "Task 30");
+        }
+        REQUIRE(finished == 98);
+    }
+
+    SECTION("Invalid number of threads") {
+        REQUIRE_THROWS_AS(ThreadPool(-1), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Per column kernels give the same result for every number of threads", "[ThreadPool][descriptiveStatistics]") {
+    std::vector<double> longCol, shortCol;
+    for (int i = 0; i < 300000; ++i) longCol.push_back(std::sin(i * 0.01) * 1000);
+    for (int i = 0; i < 300000; ++i) shortCol.push_back(i % 3);
+    DataFrame df({{"A", longCol}, {"B", shortCol}});
+
+    ThreadPool::setGlobalNumThreads(1);
+    std::vector<double> variancesSerial = descriptiveStatistics::variances(df);
+    StandardScaler scalerSerial;
+    DataFrame scaledSerial = scalerSerial.fitTransform(df);
+
+    ThreadPool::setGlobalNumThreads(4);
+    REQUIRE(ThreadPool::global().getNumThreads() == 4);
+    REQUIRE(descriptiveStatistics::variances(df) == variancesSerial);
+    StandardScaler scaler;
+    DataFrame scaled = scaler.fitTransform(df);
+    REQUIRE(scaled.getColumn(0).getDataAsDouble() == scaledSerial.getColumn(0).getDataAsDouble());
+    REQUIRE(scaled.getColumn(1).getDataAsDouble() == scaledSerial.getColumn(1).getDataAsDouble());
+
+    Column constant(ColumnType::Int);
+    constant.fillFromDouble(std::vector<double>(200000, 7.0));
+    REQUIRE(descriptiveStatistics::isConstant(constant));
+    constant.setAt(8.0, 150000);
+    REQUIRE_FALSE(descriptiveStatistics::isConstant(constant));
+
+    ThreadPool::setGlobalNumThreads(0);
+}
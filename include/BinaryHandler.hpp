@@ -0,0 +1,38 @@
+#ifndef BINARYHANDLER_H
+#define BINARYHANDLER_H
+
+#include <string>
+
+#include "DataFrame.hpp"
+
+// Native binary columnar format of a DataFrame:
+// A header with the number of rows and columns, the column names, types and buffer offsets and (optional) the row names,
+// followed by one buffer per column in its storage type. Every column buffer starts on a 64 byte boundary of the file,
+// so that a memory mapped file can be used directly as column storage
+
+namespace binaryHandler {
+        /**
+         * @brief Writes out a DataFrame in the native binary format
+         * 
+         * Columns are written in their storage type (Int, Float or Double). Row names are only written, if the DataFrame has explicit row names
+         * 
+         * @param df A DataFrame
+         * @param filename The name (and path) of the file
+         * @throws std::runtime_error If the file cannot be opened or written
+         */
+        void save(DataFrame& df, const std::string& filename);
+        /**
+         * @brief Loads a DataFrame from a file in the native binary format
+         * 
+         * The file is memory mapped and the columns read their values directly from the mapping, so no values are parsed or copied.
+         * A column is only copied into memory, before it gets modified. The mapping is released, when no column uses it anymore
+         * 
+         * @param filename The name (and path) of the file
+         * @return A DataFrame
+         * @throws std::runtime_error If the file cannot be found/opened or is no valid file of the binary format
+         */
+        DataFrame load(const std::string& filename);
+
+}
+
+#endif // BINARYHANDLER_H
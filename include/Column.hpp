@@ -2,10 +2,14 @@
 #define COLUMN_H
 
 #include <iostream>
+#include <string>
 #include <vector>
+#include <span>
 #include <memory>
 #include <stdexcept>
 #include <typeinfo>
+#include <atomic>
+#include <cstdint>
 
 
 // Uses type erasure pattern, to hide the template of the column in the outward facing class (Column), so that DataFrame is free from templates,
@@ -17,6 +21,12 @@ enum class ColumnType {
     Double
 };
 
+// Maps the storage type of a ColumnImpl to its ColumnType, used for the typed (span) access on Column
+template<typename T> struct ColumnTypeOf;
+template<> struct ColumnTypeOf<int> { static constexpr ColumnType value = ColumnType::Int; };
+template<> struct ColumnTypeOf<float> { static constexpr ColumnType value = ColumnType::Float; };
+template<> struct ColumnTypeOf<double> { static constexpr ColumnType value = ColumnType::Double; };
+
 class ColumnBase {
 public:
     virtual ~ColumnBase() = default;
@@ -27,6 +37,7 @@ public:
     virtual double getDataAtAsDouble(int index) const = 0;
     virtual void setAt(double val, int index) = 0;
     virtual void deleteAt(int index) = 0; 
+    virtual void resize(int size) = 0;
     virtual int size() const = 0;
     virtual void print() const = 0;
     virtual std::unique_ptr<ColumnBase> clone() const = 0; // For clone pattern
@@ -37,60 +48,103 @@ class ColumnImpl : public ColumnBase {
 private:
     std::vector<T> data;
     ColumnType type;
+    // Optional read-only storage, which is owned by another object (e.g. a memory mapped file). As long as it is set,
+    // the values are read from there and only copied into data, before the column gets modified
+    std::shared_ptr<const void> externalOwner;
+    std::span<const T> externalData;
+
+    std::span<const T> view() const {
+        if (externalOwner) return externalData;
+        return data;
+    }
+
+    // Copies the external storage into the own vector, so that the column can be modified
+    void materialize() {
+        if (externalOwner) {
+            data.assign(externalData.begin(), externalData.end());
+            externalData = {};
+            externalOwner.reset();
+        }
+    }
 
 public:
     ColumnImpl(ColumnType type) : type(type) {}
 
+    ColumnImpl(ColumnType type, std::span<const T> externalData, std::shared_ptr<const void> externalOwner)
+        : type(type), externalOwner(std::move(externalOwner)), externalData(externalData) {}
+
     ColumnType getType() const override {
         return type;
     }
 
     void addValue(const T& value) {
+        materialize();
         data.push_back(value);
     }
 
     void addValueFromDouble(double val) override {
+        materialize();
         data.push_back(static_cast<T>(val));
     }
 
     int size() const override {
-        return(data.size());
+        return(view().size());
     }
 
     std::vector<double> getDataAsDouble() const override {
         std::vector<double> result;
-        result.reserve(data.size());
-        for (const auto& v : data) {
+        result.reserve(size());
+        for (const auto& v : view()) {
             result.push_back(static_cast<double>(v));
         }
         return result;
     }
 
     double getDataAtAsDouble(int index) const override {
-        return(static_cast<double>(data.at(index)));
+        if (index < 0 || index >= size()) {
+            throw std::out_of_range("Index out of range in getDataAtAsDouble.");
+        }
+        return(static_cast<double>(view()[index]));
     }
 
     void deleteAt(int index) override {
-        if (index < 0 || index >= data.size()) {
+        if (index < 0 || index >= size()) {
             throw std::out_of_range("Index out of range in deleteAt.");
         }
+        materialize();
         data.erase(data.begin() + index);
     }
 
+    void resize(int size) override {
+        materialize();
+        data.resize(size);
+    }
+
     void setAt(double val, int index) override {
-        if (index < 0 || index >= data.size()) {
+        if (index < 0 || index >= size()) {
             throw std::out_of_range("Index out of range in setAt.");
         }
-        data[index] = static_cast<T>(data.at(index));
+        materialize();
+        data[index] = static_cast<T>(val);
+    }
+
+    // Views on the underlying memory, without copying or widening the data
+    std::span<const T> getData() const {
+        return view();
     }
 
-    std::vector<T>& getData() const {
+    std::span<T> getData() {
+        materialize();
         return data;
     }
 
+    bool isExternal() const {
+        return(externalOwner != nullptr);
+    }
+
     void print() const override {
         std::cout << "Data: ( ";
-        for (T x : data) {
+        for (T x : view()) {
             std::cout << x << " ";
         }
         std::cout << "); Type: " + typeToString() << std::endl;
@@ -107,15 +161,21 @@ public:
     }
 
     std::unique_ptr<ColumnBase> clone() const override {
+        // A clone of an external column only shares the read-only external storage
+        if (externalOwner) return std::make_unique<ColumnImpl<T>>(type, externalData, externalOwner);
         auto copy = std::make_unique<ColumnImpl<T>>(type);
         copy->data = data;
         return copy;
     }
 };
 
+// Copies of a Column share the same storage (copy-on-write). The storage is only copied, if a column, whose storage is shared,
+// gets modified. Note: The sharing is not synchronized, so a column should not be modified while a copy of it is used by another thread
 class Column {
     private:
-        std::unique_ptr<ColumnBase> impl;
+        std::shared_ptr<ColumnBase> impl;
+        // Changes with every (possible) modification of the values, copies which share the storage have the same version
+        std::uint64_t version = newVersion();
 
     public:
         Column(ColumnType type) {
@@ -134,6 +194,21 @@ class Column {
             }
         }
 
+        /**
+         * @brief Creates a column on top of read-only memory owned by another object, without copying the values
+         *
+         * The values are only copied, before the column is modified for the first time
+         *
+         * @tparam T The storage type of the column (int, float or double)
+         * @param data Span over the values
+         * @param owner Keeps the memory of data alive, as long as the column (or one of its copies) uses it
+         * @return A Column object
+         */
+        template<typename T>
+        static Column fromExternal(std::span<const T> data, std::shared_ptr<const void> owner) {
+            return Column(std::make_shared<ColumnImpl<T>>(ColumnTypeOf<T>::value, data, std::move(owner)));
+        }
+
         ColumnType getType() const {
             return impl->getType();
         }
@@ -143,10 +218,12 @@ class Column {
         }
 
         void addValueFromDouble(double val) {
+            detach();
             impl->addValueFromDouble(val);
         }
 
         void fillFromDouble(const std::vector<double>& vals) {
+            detach();
             for(double val : vals) impl->addValueFromDouble(val);
         }
 
@@ -155,13 +232,27 @@ class Column {
         }
 
         void deleteAt(int index) {
+            detach();
             impl->deleteAt(index);
         }
 
         void setAt(double val, int index) {
+            detach();
             impl->setAt(val, index);
         }
 
+        /**
+         * @brief Changes the number of values, new values are initialized with 0
+         *
+         * Used to pre-size a column, which is then filled via getSpan
+         *
+         * @param size The new number of values
+         */
+        void resize(int size) {
+            detach();
+            impl->resize(size);
+        }
+
         int size() const {
             return(impl->size());
         }
@@ -170,35 +261,117 @@ class Column {
             impl->print();
         }
 
-        // Rule of 5´
-        // Copy constructor DIY added, to allow deepcopy of a column, instead of copying the pointer
-        // Copy ctor
-        Column(const Column& other) {
-            impl = other.impl->clone();
-        }
-        
-        // Copy assignement
-        Column& operator=(const Column& other) {
-            if (this != &other) {
-                impl = other.impl->clone();
-            }
-            return *this;
-        }
-
-        // Moving ctor
+        // Rule of 5
+        // Copies only share the storage, the deep copy is deferred to the first modification (see detach)
+        Column(const Column& other) = default;
+        Column& operator=(const Column& other) = default;
         Column(Column&&) = default;
-        // Moving assignement
         Column& operator=(Column&&) = default;
-
-        // Deconstructor
-        // Default is enough, since it the class is based on a unique_ptr which handles the memory life
+        // Default is enough, since it the class is based on a shared_ptr which handles the memory life
         ~Column() = default;
 
+        /**
+         * @brief Checks if the column shares its storage with another column
+         * @return true if at least one other copy of this column uses the same storage
+         */
+        bool isShared() const {
+            return(impl.use_count() > 1);
+        }
+
         double getDataAtAsDouble(int index) const {
             return(impl->getDataAtAsDouble(index));
         }
 
+        /**
+         * @brief Returns a view on the internally stored data, without copying it
+         *
+         * The view is invalidated, if values are added to or deleted from the column
+         *
+         * @tparam T The storage type of the column (int, float or double)
+         * @return A span over the column values
+         * @throws std::invalid_argument If T does not match the type of the column
+         */
+        template<typename T>
+        std::span<const T> getSpan() const {
+            checkType<T>();
+            return static_cast<const ColumnImpl<T>&>(*impl).getData();
+        }
+
+        template<typename T>
+        std::span<T> getSpan() {
+            checkType<T>();
+            detach();
+            return static_cast<ColumnImpl<T>&>(*impl).getData();
+        }
+
+        /**
+         * @brief Calls the visitor with a span over the column values in their native storage type
+         *
+         * The visitor has to accept std::span<const int>, std::span<const float> and std::span<const double>
+         * (e.g. a generic lambda taking auto) and has to return the same type for all of them
+         *
+         * @param visitor Callable, which gets the typed span of the column
+         * @return The return value of the visitor
+         */
+        template<typename Visitor>
+        decltype(auto) visit(Visitor&& visitor) const {
+            switch (impl->getType()) {
+                case ColumnType::Int: return visitor(getSpan<int>());
+                case ColumnType::Float: return visitor(getSpan<float>());
+                default: return visitor(getSpan<double>());
+            }
+        }
+
+        template<typename Visitor>
+        decltype(auto) visit(Visitor&& visitor) {
+            switch (impl->getType()) {
+                case ColumnType::Int: return visitor(getSpan<int>());
+                case ColumnType::Float: return visitor(getSpan<float>());
+                default: return visitor(getSpan<double>());
+            }
+        }
+
+        /**
+         * @brief Returns the version of the values, which changes whenever the column is modified
+         *
+         * Columns with the same version hold the same values, so the version identifies cached results (e.g. statistics).
+         * Mutable access (non-const getSpan or visit) counts as modification
+         *
+         * @return The version number
+         */
+        std::uint64_t getVersion() const {
+            return version;
+        }
+
+        /**
+         * @brief Returns a new, globally unique version number (for columns and DataFrames)
+         * @return The version number
+         */
+        static std::uint64_t newVersion() {
+            static std::atomic<std::uint64_t> lastVersion{0};
+            return ++lastVersion;
+        }
+
         Column() = delete;
+
+    private:
+        explicit Column(std::shared_ptr<ColumnBase> impl) : impl(std::move(impl)) {}
+
+        // Gives the column its own copy of the storage before it gets modified, if the storage is shared with other columns.
+        // Called before every modification, so the column also gets a new version
+        void detach() {
+            if (impl.use_count() > 1) {
+                impl = impl->clone();
+            }
+            version = newVersion();
+        }
+
+        template<typename T>
+        void checkType() const {
+            if (impl->getType() != ColumnTypeOf<T>::value) {
+                throw std::invalid_argument("Requested type does not match the column type " + impl->typeToString());
+            }
+        }
 };
 
 
@@ -4,12 +4,57 @@
 
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <sstream>
+#include <string>
+#include <vector>
 
 
 #include "DataFrame.hpp"
 
 namespace csvHandler {
+        /**
+         * @brief Options for reading a Csv file
+         */
+        struct CsvReadOptions {
+            // If true, the first value of every line is the row name
+            bool hasRowNames = false;
+            // The delimeter for ending a entry, e.g. ',' or ';'
+            char delimiter = ',';
+            // Number of ranges of the file, which are parsed in parallel on the ThreadPool, 0 uses the number of threads of the pool.
+            // Small files are always parsed as a single range
+            int numThreads = 1;
+            // Columns to read, either by name or by index (without the row name column), in the order of the resulting DataFrame.
+            // If both are empty, all columns are read. Values of other columns are skipped without converting them
+            std::vector<std::string> columns;
+            std::vector<int> columnIndices;
+            // Number of data rows (after the header) to skip
+            int skipRows = 0;
+            // Maximal number of rows to read after the skipped rows, -1 reads all rows
+            int maxRows = -1;
+            // If true, every column is stored in the narrowest type, which holds its values without loss: Int for integral values,
+            // Float if every value is representable as float within floatTolerance, Double otherwise
+            bool inferTypes = false;
+            // Allowed relative error |float(x) - x| <= floatTolerance * |x| for storing a column as Float, 0 requires exact values
+            double floatTolerance = 0.0;
+            // Number of rows, from which the type of a column is inferred, -1 uses all rows. The inferred type is verified on
+            // all rows, a column falls back to a wider type, if a row outside of the sample does not fit
+            int inferenceSampleRows = -1;
+        };
+
+        /**
+         * @brief Options for writing a Csv file
+         */
+        struct CsvWriteOptions {
+            // If true, the row names are written as first value of every line
+            bool includeRowNames = false;
+            // The delimeter for ending a entry, e.g. ',' or ';'
+            char delimiter = ',';
+            // Number of blocks of rows, which are formatted in parallel on the ThreadPool, 0 uses the number of threads of the pool.
+            // Small DataFrames are always formatted as a single block
+            int numThreads = 1;
+        };
+
         /**
          * @brief Reads a Csv file in as DataFrame
          * 
@@ -21,6 +66,19 @@ namespace csvHandler {
          * @throws exception If the file cannot be found/opened or values cannot be parsed into double values
          */
         DataFrame fromCSV(const std::string& filename, bool hasRowNames = false, char delimiter = ',');
+        /**
+         * @brief Reads a Csv file in as DataFrame
+         * 
+         * Csv is allowed to have headers, but only numeric values. All Columns will have type double, unless inferTypes is set.
+         * With more than one thread, the file is split into ranges of whole lines, which are parsed in parallel
+         * 
+         * @param filename The name (and path) of the file
+         * @param options The CsvReadOptions, e.g. delimiter and number of threads
+         * @return A DataFrame
+         * @throws exception If the file cannot be found/opened or values cannot be parsed into double values
+         * @throws std::invalid_argument If selected columns do not exist or the row range is invalid
+         */
+        DataFrame fromCSV(const std::string& filename, const CsvReadOptions& options);
         /**
          * @brief Writes out DataFrame to an Csv
          * 
@@ -31,7 +89,85 @@ namespace csvHandler {
          * @return A DataFrame
          * @throws exception If the path cannot be found or no writting permitted
          */
-        void toCSV(DataFrame& df, const std::string& filename, bool includeRowNames = false, char delimiter = ',');
+        void toCSV(const DataFrame& df, const std::string& filename, bool includeRowNames = false, char delimiter = ',');
+        /**
+         * @brief Writes out DataFrame to an Csv
+         * 
+         * Column names will be used as headers. Values are written in their shortest form, which reads back to the same value.
+         * Blocks of rows are formatted into buffers (in parallel, if more than one thread is used) and written in order
+         * 
+         * @param df The DataFrame
+         * @param filename The name (and path) of the file
+         * @param options The CsvWriteOptions, e.g. delimiter and number of threads
+         * @throws exception If the path cannot be found or no writting permitted
+         */
+        void toCSV(const DataFrame& df, const std::string& filename, const CsvWriteOptions& options);
+
+        /**
+         * @brief Reads a Csv file in batches of rows, so that files larger than the memory can be processed
+         * 
+         * Only one block of the file and one batch are held in memory. The next block of the file is read on a background thread,
+         * while the current one is parsed. The buffers of a batch are reused for the next batch, if the batch is not used anymore
+         * (e.g. if the same DataFrame is passed to next again). Row names of a batch are implicit, unless the file has row names.
+         * The column selection and the row range of the options are applied, numThreads is not used, every batch is parsed by the calling thread.
+         * Type inference is not used either, all columns of a batch have type double, so that all batches have the same types
+         */
+        class CsvBatchReader {
+            private:
+                static constexpr std::size_t blockSize = 4 << 20;
+
+                std::ifstream file;
+                int batchSize;
+                CsvReadOptions options;
+                std::vector<std::string> colNames;
+                // Number of fields per line and the positions of the selected columns in a line
+                int nrFields = 0;
+                std::vector<int> selectedFields;
+                // Buffers of the batches, which are reused if they are not shared with an old batch anymore
+                std::vector<Column> columns;
+                std::vector<std::string> rowNames;
+                // Read but not yet parsed data of the file starts at pos
+                std::vector<char> buffer;
+                std::size_t pos = 0;
+                std::vector<char> readaheadBuffer;
+                std::future<std::size_t> readahead;
+                int rowsRead = 0;
+
+                void startReadahead();
+                /**
+                 * @brief Appends the block read by the readahead thread to the buffer and starts reading the next block
+                 * @return false if the end of the file was reached, true otherwise
+                 */
+                bool refill();
+
+            public:
+                /**
+                 * @brief Opens a Csv file and reads its header
+                 * @param filename The name (and path) of the file
+                 * @param batchSize Int, maximal number of rows per batch
+                 * @param options The CsvReadOptions, e.g. delimiter
+                 * @throws exception If the file cannot be found/opened or the batch size is not positive
+                 */
+                CsvBatchReader(const std::string& filename, int batchSize, const CsvReadOptions& options = {});
+                ~CsvBatchReader();
+
+                CsvBatchReader(const CsvBatchReader&) = delete;
+                CsvBatchReader& operator=(const CsvBatchReader&) = delete;
+
+                /**
+                 * @brief Reads the next batch of rows
+                 * @param batch DataFrame, which is replaced by the next batch
+                 * @return false if there are no more rows (batch is then empty), true otherwise
+                 * @throws exception If values cannot be parsed, the row numbers in the message count from the start of the file
+                 */
+                bool next(DataFrame& batch);
+                std::vector<std::string> getColNames() const;
+                /**
+                 * @brief Returns the number of rows read in all previous batches
+                 * @return Int
+                 */
+                int getRowsRead() const;
+        };
 
 }
 
@@ -9,28 +9,70 @@
 #include <algorithm>
 #include <iomanip>
 #include <span>
+#include <array>
 
 #include "Column.hpp"
 
 
+class DataFrame;
+
+namespace descriptiveStatistics {
+        class StatisticsCache;
+        StatisticsCache& cacheOf(const DataFrame& df);
+}
+
 class DataFrame {
     private:
-        std::unordered_map<std::string, Column> columns;
-        std::unordered_map<int, std::string> colIndexToName;
-        std::unordered_map<std::string, int> rowNameToIndex;
+        // Column directory: The columns are stored by position, the name index maps a column name to its position
+        std::vector<Column> columns;
         std::vector<std::string> columnNames;
+        std::unordered_map<std::string, int> colNameToIndex;
+        // Row names are only stored, if they were given explicitly. Otherwise a row is labeled "R" + its position.
+        // The lookup table for the row names is built on the first lookup by name
         std::vector<std::string> rowNames;
+        mutable std::unordered_map<std::string, int> rowNameToIndex;
+        mutable bool rowIndexBuilt = false;
 
         int nrCols;
         int nrRows;
 
+        // Changes with every modification of the DataFrame (values, rows, columns or names), see getVersion
+        std::uint64_t version = Column::newVersion();
+        // Memoized statistics of the columns (see descriptiveStatistics), created on first use. The results are stored by column version,
+        // so copies of the DataFrame can share the cache
+        mutable std::shared_ptr<descriptiveStatistics::StatisticsCache> statisticsCache;
+        friend descriptiveStatistics::StatisticsCache& descriptiveStatistics::cacheOf(const DataFrame& df);
+
+        /**
+         * @brief Gives the DataFrame a new version, called by every mutator
+         */
+        void touch();
+
         /**
          * @brief Checks if any out of a collection of indices is out of range for rows
          * @param indices A collection of indices for rows
          * @return true if the DataFrame has no rows or no columns, false otherwise.
          */
-        void checkIndexOutOfRange(const std::span<int>& indices, bool row);
-        void checkIndexOutOfRange(int index, bool row);
+        void checkIndexOutOfRange(const std::span<int>& indices, bool row) const;
+        void checkIndexOutOfRange(int index, bool row) const;
+        /**
+         * @brief Returns the position of a column, given its name
+         * @param col String of the column name
+         * @return Index of the column
+         * @throws std::invalid_argument If no column with this name exists
+         */
+        int getColumnIndex(const std::string& col) const;
+        /**
+         * @brief Returns the position of a row, given its name
+         * @param row String of the row name
+         * @return Index of the row
+         * @throws std::invalid_argument If no row with this name exists
+         */
+        int getRowIndex(const std::string& row) const;
+        /**
+         * @brief Stores the implicit row names explicitly, e.g. before rows get dropped and the positions change
+         */
+        void materializeRowNames();
 
     public:
 
@@ -45,7 +87,7 @@ class DataFrame {
          *
          * @return true if the DataFrame has no rows or no columns, false otherwise.
          */
-        bool empty();
+        bool empty() const;
         /**
          * @brief Returns a row as double vector, given a numeric row index
          * @param row Index of the row
@@ -60,16 +102,50 @@ class DataFrame {
         std::vector<double> getRow(std::string row);
         /**
          * @brief Returns a Column, given a numeric column index
+         *
+         * The returned reference gives access to the data without copying it (e.g. via Column::visit). It is invalidated if columns are added or dropped
+         *
          * @param col Index of the column
-         * @return Column object
+         * @return Reference to the Column object
          */
-        Column getColumn(int col);
+        const Column& getColumn(int col) const;
         /**
          * @brief Returns a Column, given a column name
+         *
+         * The returned reference gives access to the data without copying it (e.g. via Column::visit). It is invalidated if columns are added or dropped
+         *
          * @param col String of the column name
-         * @return Column object
+         * @return Reference to the Column object
+         */
+        const Column& getColumn(std::string col) const;
+        /**
+         * @brief Returns a writable view on the values of a column, e.g. to overwrite them without allocating
+         *
+         * Counts as modification of the column (its storage is copied first, if it is shared). The view is invalidated,
+         * if rows are added or dropped
+         *
+         * @tparam T The storage type of the column (int, float or double)
+         * @param col Index of the column
+         * @return A span over the column values
+         * @throws std::invalid_argument If the index is invalid or T does not match the type of the column
+         */
+        template<typename T>
+        std::span<T> getColumnSpan(int col) {
+            checkIndexOutOfRange(col, false);
+            std::span<T> data = columns[col].getSpan<T>();
+            touch();
+            return data;
+        }
+        /**
+         * @brief Replaces a column, keeping its name and position
+         *
+         *  The storage of the column is shared with the given column and only copied, if one of both gets modified
+         *
+         * @param col Index of the column
+         * @param newCol The Column
+         * @throws std::invalid_argument If the index is invalid or the new column has not the same number of entries as the DataFrame
          */
-        Column getColumn(std::string col);
+        void setColumn(int col, const Column& newCol);
         /**
          * @brief Returns the type in which the column is saved in internally, given a numeric index
          * @param col Index of the column
@@ -182,6 +258,16 @@ class DataFrame {
          * @throws std::invalid_argument If the new row has not the same number of entries as already existing rows, or no column exist yet
          */
         void addColumn(std::vector<double>& newCol, const std::string& colName, ColumnType type = ColumnType::Double);      
+        /**
+         * @brief Adds a Column object
+         * 
+         *  The storage of the column is shared with the given column and only copied, if one of both gets modified
+         * 
+         * @param newCol The Column
+         * @param colName String of the column name
+         * @throws std::invalid_argument If the new column has not the same number of entries as already existing columns
+         */
+        void addColumn(const Column& newCol, const std::string& colName);
         /**
          * @brief Adds a Row from a double vector
          * 
@@ -230,20 +316,34 @@ class DataFrame {
          */
         void dropRow(std::string& row);
         /**
-         * @brief Returns vector of column names
+         * @brief Returns vector of row names
+         *
+         * If the DataFrame has no explicit row names, the names are generated ("R" + row index)
+         *
          * @return String vector
          */
-        std::vector<std::string> getRowNames();
+        std::vector<std::string> getRowNames() const;
         /**
-         * @brief Returns vector of row names
+         * @brief Returns the name of a single row, without generating all row names
+         * @param row Index of the row
+         * @return String of the row name
+         */
+        std::string getRowName(int row) const;
+        /**
+         * @brief Checks if the DataFrame has explicitly set row names
+         * @return false if the rows are only labeled implicitly by their position, true otherwise
+         */
+        bool hasRowNames() const;
+        /**
+         * @brief Returns vector of column names
          * @return String vector
          */
-        std::vector<std::string> getColNames();
+        std::vector<std::string> getColNames() const;
         /**
          * @brief Returns the dimensions of the DataFrame (nr. rows, nr. columns)
          * @return A pair of ints
          */
-        std::pair<int, int> getDim();
+        std::pair<int, int> getDim() const;
         /**
          * @brief Sets new rownames
          * @param rowNames String vector of the new row names
@@ -256,6 +356,15 @@ class DataFrame {
          * @throws std::invalid_argument If the number of new column names is not equal to the number of columns in the DataFrame
          */
         void setColNames(std::vector<std::string> columnNames);
+        /**
+         * @brief Returns the version of the DataFrame, which changes whenever the DataFrame is modified
+         *
+         * Versions are unique over all DataFrames, so two DataFrames with the same version hold the same data (e.g. a copy, which was
+         * not modified yet). This can be used to cache results derived from the DataFrame
+         *
+         * @return The version number
+         */
+        std::uint64_t getVersion() const;
         /**
          * @brief Makes a pretty print of the DataFrame in the console
          */
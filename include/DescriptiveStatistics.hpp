@@ -3,11 +3,89 @@
 
 #include <vector>
 #include <string>
+#include <limits>
+#include <string_view>
 #include <Eigen/Dense>
 #include "DataFrame.hpp"
+#include "QuantileSketch.hpp"
 
 
 namespace descriptiveStatistics {
+        /**
+         * @brief Summary statistics of a column (count, mean, sum of squared deviations M2, min, max)
+         *
+         * Summaries of parts of a column can be merged (Chan et al.), which gives the same result as summarizing the whole column
+         */
+        struct ColumnSummary {
+            long long count = 0;
+            double mean = 0.0;
+            double m2 = 0.0;
+            double min = std::numeric_limits<double>::infinity();
+            double max = -std::numeric_limits<double>::infinity();
+
+            /**
+             * @brief Adds a single value (Welford update)
+             * @param val The value
+             */
+            void add(double val);
+            /**
+             * @brief Merges the summary of other values into this summary
+             * @param other The summary of the other values
+             */
+            void merge(const ColumnSummary& other);
+            /**
+             * @brief Returns the sample variance M2 / (count - 1)
+             * @return double value, NaN if count is smaller than 2
+             */
+            double variance() const;
+            /**
+             * @brief Returns the sample standard deviation
+             * @return double value, NaN if count is smaller than 2
+             */
+            double standardDeviation() const;
+        };
+
+        /**
+         * @brief Summarizes a column in a single pass over its values
+         *
+         * The values are processed in cache sized blocks, every block is summarized with two passes over the cached values
+         * and merged into the result, which is numerically stable without a division per value.
+         * Long columns are split into chunks, which are summarized in parallel on the ThreadPool
+         *
+         * @param col A Column object
+         * @return The ColumnSummary of the column
+         */
+        ColumnSummary summarize(const Column& col);
+        /**
+         * @brief Summarizes all columns of a DataFrame in parallel (see summarize)
+         *
+         * The summaries are memoized in the DataFrame by column version, so only columns modified since the last call
+         * (e.g. by set, addRow or dropRow) are scanned again. means, variances, standardDeviations, constantColumns and covariances
+         * are served from the memoized summaries as well
+         *
+         * @param df A DataFrame
+         * @return One ColumnSummary per column
+         */
+        std::vector<ColumnSummary> describe(const DataFrame& df);
+        /**
+         * @brief Summarizes all columns of a DataFrame and builds a quantile sketch per column in the same scan
+         * @param df A DataFrame
+         * @param sketches Is filled with one QuantileSketch per column
+         * @param k Accuracy parameter of the sketches (see QuantileSketch)
+         * @param exactLimit Number of values per column, for which the quantiles are exact (see QuantileSketch)
+         * @return One ColumnSummary per column
+         */
+        std::vector<ColumnSummary> describe(const DataFrame& df, std::vector<QuantileSketch>& sketches, int k = 200, std::size_t exactLimit = 0);
+        /**
+         * @brief Calculates the q-quantiles of the columns of a DataFrame from quantile sketches
+         * @param df A DataFrame
+         * @param q The probability in [0, 1], e.g. 0.5 for the medians
+         * @param k Accuracy parameter of the sketches (see QuantileSketch)
+         * @param exactLimit Number of values per column, for which the quantiles are exact. Larger columns get approximate quantiles
+         * @return A double vector
+         * @throws std::invalid_argument If the DataFrame is empty or q is not in [0, 1]
+         */
+        std::vector<double> quantiles(const DataFrame& df, double q, int k = 200, std::size_t exactLimit = 100000);
         /**
          * @brief Calculates the means of the columns of a DataFrame
          * @param df A DataFrame
@@ -31,19 +109,126 @@ namespace descriptiveStatistics {
          * @param df A DataFrame
          * @return A DataFrame
          */
-        DataFrame covariances(DataFrame& df);
+        DataFrame covariances(const DataFrame& df);
         /**
          * @brief Calculates the Covariance matrix as a MatrixXd of a DataFrame
+         *
+         * The matrix is memoized in the DataFrame, until one of its columns is modified, added or dropped
+         *
          * @param df A DataFrame
          * @return A DataFrame
          */
-        Eigen::MatrixXd covariancesEigen(DataFrame& df);
+        Eigen::MatrixXd covariancesEigen(const DataFrame& df);
+        /**
+         * @brief Calculates the (Pearson) Correlation matrix as a DataFrame of a DataFrame
+         * @param df A DataFrame
+         * @param pairwiseComplete If true, the correlation of every pair of columns uses only the rows, in which both values are not NaN
+         * @return A DataFrame
+         */
+        DataFrame correlations(const DataFrame& df, bool pairwiseComplete = false);
+        /**
+         * @brief Calculates the (Pearson) Correlation matrix as a MatrixXd of a DataFrame
+         *
+         * Without pairwiseComplete, the covariance matrix is scaled by the standard deviations, NaN values propagate.
+         * With pairwiseComplete, the sums of every pair over its complete rows are calculated in one pass with matrix products
+         * of the values and their validity masks, without copying columns per pair. Pairs with fewer than 2 complete rows are NaN,
+         * correlations with a constant column are NaN in both cases
+         *
+         * @param df A DataFrame
+         * @param pairwiseComplete If true, the correlation of every pair of columns uses only the rows, in which both values are not NaN
+         * @return A MatrixXd
+         */
+        Eigen::MatrixXd correlationsEigen(const DataFrame& df, bool pairwiseComplete = false);
+        /**
+         * @brief Accumulates the covariance matrix over batches of rows, without keeping the rows
+         *
+         * Holds the number of rows, the column means and the co-moment matrix (sum of the products of the centered values).
+         * Accumulators of different parts of the data (e.g. from other threads, Csv batches or processes) can be merged (Chan et al.),
+         * the result is the same as accumulating all rows in one accumulator
+         */
+        class CovarianceAccumulator {
+            private:
+                long long count = 0;
+                std::vector<std::string> colNames;
+                Eigen::VectorXd meansVec;
+                Eigen::MatrixXd coMoments;
+
+                void checkColNames(const std::vector<std::string>& otherColNames) const;
+
+            public:
+                CovarianceAccumulator() = default;
+
+                /**
+                 * @brief Adds the rows of a batch
+                 * @param batch A DataFrame with the same columns (in the same order) as the batches added before
+                 * @throws std::invalid_argument If the columns differ from the columns of the batches before
+                 */
+                void add(const DataFrame& batch);
+                /**
+                 * @brief Merges the rows accumulated by another accumulator into this accumulator
+                 * @param other An accumulator over the same columns
+                 * @throws std::invalid_argument If the columns differ
+                 */
+                void merge(const CovarianceAccumulator& other);
+                /**
+                 * @brief Returns the number of accumulated rows
+                 * @return long long value
+                 */
+                long long getCount() const;
+                /**
+                 * @brief Returns the names of the accumulated columns
+                 * @return String vector
+                 */
+                std::vector<std::string> getColNames() const;
+                /**
+                 * @brief Returns the means of the accumulated columns
+                 * @return A double vector
+                 */
+                std::vector<double> getMeans() const;
+                /**
+                 * @brief Calculates the Covariance matrix as a MatrixXd of the accumulated rows
+                 * @return A MatrixXd
+                 * @throws std::invalid_argument If fewer than 2 rows were accumulated
+                 */
+                Eigen::MatrixXd covariancesEigen() const;
+                /**
+                 * @brief Calculates the Covariance matrix as a DataFrame of the accumulated rows (e.g. as input for PCA::fit with isCovariance = true)
+                 * @return A DataFrame
+                 * @throws std::invalid_argument If fewer than 2 rows were accumulated
+                 */
+                DataFrame covariances() const;
+                /**
+                 * @brief Serializes the state into a compact binary blob
+                 *
+                 * Contains the number of rows, the column names, the means and the lower triangle of the co-moment matrix
+                 *
+                 * @return The blob as string of bytes
+                 */
+                std::string serialize() const;
+                /**
+                 * @brief Restores an accumulator from a blob created by serialize
+                 * @param blob The blob
+                 * @return A CovarianceAccumulator
+                 * @throws std::runtime_error If the blob is invalid
+                 */
+                static CovarianceAccumulator deserialize(std::string_view blob);
+        };
+
         /**
          * @brief Checks if a Column is constant
+         *
+         * Long columns are checked in chunks in parallel on the ThreadPool
+         *
          * @param col A Column object
          * @return true if the values in the column are constant, false otherwise
          */
-        bool isConstant(Column& col);
+        bool isConstant(const Column& col);
+        /**
+         * @brief Checks for every column of a DataFrame, if it is constant, based on the memoized summaries (see describe)
+         * @param df A DataFrame
+         * @return One flag per column, true if the values in the column are constant
+         */
+        std::vector<bool> constantColumns(const DataFrame& df);
 
 
 }
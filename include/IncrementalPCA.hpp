@@ -0,0 +1,62 @@
+#ifndef INCREMENTALPCA_H
+#define INCREMENTALPCA_H
+
+#include <vector>
+#include <string>
+#include <Eigen/Dense>
+#include "DataFrame.hpp"
+#include "CastingHelper.hpp"
+
+
+/**
+ * @brief PCA, which is fitted batch by batch (Ross et al., Incremental Learning for Robust Visual Tracking)
+ *
+ * Only the running mean and a truncated SVD of the centered data seen so far (k singular values and vectors) are kept,
+ * so the memory is O(k * p) for any number of rows. Every batch is stacked below the scaled singular vectors (plus a row,
+ * which corrects the shift of the mean) and the SVD of this small matrix gives the new state. The data is always centered
+ */
+class IncrementalPCA {
+private:
+    int nComponents;
+    long long count = 0;
+    int colsOfFit = 0;
+    Eigen::RowVectorXd mean;
+    Eigen::VectorXd singularValues;
+    // The right singular vectors as rows (nr. components x p)
+    Eigen::MatrixXd components;
+
+public:
+    /**
+     * @brief Creates an unfitted IncrementalPCA
+     * @param nComponents Int, number of Principal Components to be kept
+     * @throws std::invalid_argument If nComponents is smaller than 1
+     */
+    explicit IncrementalPCA(int nComponents);
+
+    /**
+     * @brief Updates the mean and the components with another batch of the data
+     *
+     * The first batch determines the number of columns. Until the number of rows seen is at least nComponents, fewer components are available
+     *
+     * @param df DataFrame with the same columns as the previous batches
+     * @throws std::invalid_argument If the DataFrame is empty or the number of columns differs from the previous batches
+     */
+    void partialFit(DataFrame& df);
+    /**
+     * @brief Projects the input data, which is centered with the mean of the fitted data
+     * @param df Dataframe
+     * @param dim Int, number of Principal Components to be returned
+     * @return A DataFrame with Principal Components
+     * @throws std::runtime_error If no batch was fitted yet or the number of columns differs
+     * @throws std::invalid_argument If dim is not greater than 0
+     */
+    DataFrame transform(DataFrame& df, int dim = 2);
+
+    long long getCount() const;
+    std::vector<double> getMeans() const;
+    std::vector<double> getEigenvalues() const;
+    std::vector<std::vector<double>> getEigenvectors() const;
+    DataFrame getEigenInformation() const;
+};
+
+#endif // INCREMENTALPCA_H
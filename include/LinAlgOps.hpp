@@ -9,16 +9,53 @@
 namespace linAlgOps {
         /**
          * @brief Calculates the SVD
-         * @param df A DataFrame
+         *
+         * The one-sided Jacobi SVD is the most accurate, the divide-and-conquer SVD (BDCSVD) is much faster for large matrices
+         *
+         * @param X The data matrix
+         * @param divideAndConquer Bool, true to use the divide-and-conquer SVD instead of the Jacobi SVD
          * @return A pair of the eigenvalues as vector and the matrix with the eigenvectors
          */
-        std::pair<Eigen::VectorXd, Eigen::MatrixXd> singularValueDecomposition(Eigen::MatrixXd& X);        
+        std::pair<Eigen::VectorXd, Eigen::MatrixXd> singularValueDecomposition(Eigen::MatrixXd& X, bool divideAndConquer = false);
         /**
          * @brief Calculates the Spectraldecomposition
          * @param df A DataFrame
          * @return A pair of the eigenvalues as vector and the matrix with the eigenvectors
          */
         std::pair<Eigen::VectorXd, Eigen::MatrixXd> spectralDecomposition(Eigen::MatrixXd& X);
+        /**
+         * @brief Calculates the k largest eigenvalues and their eigenvectors of a symmetric matrix with the Lanczos method
+         *
+         * The Krylov subspace is extended (with full reorthogonalization) until the residuals of the top k Ritz pairs are below
+         * tol times the largest eigenvalue, which needs only a few matrix vector products, if k is small compared to the size.
+         * The start vector is drawn from a generator with a constant seed, so the results are reproducible
+         *
+         * @param X Symmetric MatrixXd (p x p)
+         * @param k Number of eigenpairs
+         * @param tol Relative tolerance of the residuals
+         * @return A pair of the eigenvalues as vector and the matrix with the eigenvectors
+         * @throws std::invalid_argument If X is not square or k is not in [1, p]
+         */
+        std::pair<Eigen::VectorXd, Eigen::MatrixXd> lanczosEigen(const Eigen::MatrixXd& X, int k, double tol = 1e-10);
+        /**
+         * @brief Calculates the top k singular vectors with a randomized range finder (Halko, Martinsson & Tropp)
+         *
+         * The range of A is sampled with k + oversampling random vectors, refined by power iterations, and the SVD is calculated
+         * on the projection of A onto this range, which costs O(n * p * (k + oversampling)) per iteration instead of a full SVD.
+         * A = (X - 1 * center^T) * diag(scale) is only applied to vectors, so centered and scaled data is never materialized.
+         * The random vectors are drawn from a generator with a constant seed, so the results are reproducible
+         *
+         * @param X The data matrix (n x p)
+         * @param k Number of components
+         * @param center Vector of length p, which is subtracted from every row of X, no centering if empty
+         * @param scale Vector of length p, with which every row of X is multiplied after centering, no scaling if empty
+         * @param oversampling Number of additional random vectors, which improve the accuracy of the top k components
+         * @param powerIterations Number of power iterations, which improve the accuracy for slowly decaying spectra
+         * @return A pair of the eigenvalues (squared singular values / (n - 1)) as vector and the matrix with the k eigenvectors
+         * @throws std::invalid_argument If k is not in [1, min(n, p)], a parameter is negative or center or scale have the wrong length
+         */
+        std::pair<Eigen::VectorXd, Eigen::MatrixXd> randomizedSvd(const Eigen::MatrixXd& X, int k, const Eigen::VectorXd& center = Eigen::VectorXd(),
+                                                                  const Eigen::VectorXd& scale = Eigen::VectorXd(), int oversampling = 10, int powerIterations = 2);
 }
 
 #endif // LINALGOPS_H
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+
+// Read-only memory mapping of a whole file (POSIX mmap). The mapping is released, when the object is destroyed,
+// so columns which point into the mapping hold it via a shared_ptr
+class MappedFile {
+    private:
+        const char* mappedData = nullptr;
+        std::size_t mappedSize = 0;
+
+    public:
+        /**
+         * @brief Maps a file read-only into memory
+         * @param filename The name (and path) of the file
+         * @throws std::runtime_error If the file cannot be opened or mapped
+         */
+        explicit MappedFile(const std::string& filename);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const char* data() const {
+            return mappedData;
+        }
+
+        std::size_t size() const {
+            return mappedSize;
+        }
+};
+
+#endif // MAPPEDFILE_H
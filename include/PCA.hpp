@@ -11,6 +11,25 @@
 #include "LinAlgOps.hpp"
 
 
+/**
+ * @brief Solvers for the eigendecomposition in PCA::fit
+ *
+ * CovarianceEigen: Eigendecomposition of the covariance matrix, fast for many rows and few variables.
+ * Jacobi: Jacobi SVD of the centered data, the most accurate but slowest solver.
+ * BDC: Divide-and-conquer SVD of the centered data, for data with more variables than rows.
+ * Randomized: Randomized SVD (see linAlgOps::randomizedSvd), for few components of many variables.
+ * Lanczos: Lanczos method on the covariance matrix (see linAlgOps::lanczosEigen), for few components of a large covariance matrix.
+ * Auto: Chooses one of the solvers above from the shape of the data and the number of components (see PCA::chooseSolver)
+ */
+enum class PcaSolver {
+    Auto,
+    CovarianceEigen,
+    Jacobi,
+    BDC,
+    Randomized,
+    Lanczos
+};
+
 class PCA {
 private:
     std::vector<std::pair<double, Eigen::VectorXd>> eigenPairs;
@@ -18,14 +37,31 @@ private:
     StandardScaler stdscaler; // For optional normalization of data
     bool hasFitted = false;
     int colsOfFit = 0;
+    // The normalization is folded into the projection: With the eigenvectors V, the means m and the standard deviations s,
+    // the scores of the raw data X are X * diag(1/s) * V - m^T * diag(1/s) * V = X * projection + offset
+    Eigen::MatrixXd projection;
+    Eigen::RowVectorXd offset;
 
     /**
-     * @brief Helper function for fit, which does the actual calculation of the Eigendecomposition
-     * @param covMat Symmetryc MatrixXd
+     * @brief Returns the means and (only if centerAndScale is true, otherwise empty) the inverse standard deviations of the fitted StandardScaler
+     * @return A pair of VectorXd
+     */
+    std::pair<Eigen::VectorXd, Eigen::VectorXd> normalization();
+    /**
+     * @brief Stores the eigenpairs, sorted by decreasing eigenvalue
+     * @param eigenvalues VectorXd of the eigenvalues
+     * @param eigenvectors MatrixXd with the eigenvectors as columns
      */
-    void fitHelper(Eigen::MatrixXd X, bool svd);
+    void setEigenPairs(const Eigen::VectorXd& eigenvalues, const Eigen::MatrixXd& eigenvectors);
+    /**
+     * @brief Builds projection and offset from the eigenvectors and the fitted StandardScaler
+     */
+    void updateProjection();
     /**
      * @brief Helper function for transform, which does the actual calculation of the projection
+     *
+     * The raw data is multiplied with the projection matrix, no normalized copy of the data is made
+     *
      * @param df Dataframe
      * @param dim Int, number of Principal Components to be returned
      * @return A DataFrame with Principal Components
@@ -43,11 +79,41 @@ public:
 
     /**
      * @brief Fits PCA to the data
+     *
+     * All solvers decompose the covariance matrix of the (centered) data, or the correlation matrix if centerAndScale is true
+     *
      * @param df DataFrame
      * @param centerAndScale Bool, true if the input should be normalized (centered and scaled). Input is ignored, if isCovariance = true
-     * @param isCovariance Bool, true if the df is a symmetric (covariance) matrix
+     * @param solver PcaSolver Enum value, Auto chooses the solver with chooseSolver
+     * @param isCovariance Bool, true if the df is a symmetric (covariance) matrix. Then only CovarianceEigen and Lanczos are used
+     * @param nComponents Int, number of Principal Components to be calculated, 0 for all
+     * @throws std::invalid_argument If the DataFrame has fewer than two variables or nComponents is not in [0, nr. variables]
+     */
+    void fit(DataFrame& df, bool centerAndScale = false, PcaSolver solver = PcaSolver::Auto, bool isCovariance = false, int nComponents = 0);
+    /**
+     * @brief Chooses the fastest solver for the shape of the data, with thresholds from Examples/PcaSolverBenchmark.cpp
+     * @param n Int, number of rows
+     * @param p Int, number of variables
+     * @param nComponents Int, number of requested components, 0 for all
+     * @param isCovariance Bool, true if a covariance matrix is decomposed
+     * @return PcaSolver Enum value (never Auto or Jacobi)
+     */
+    static PcaSolver chooseSolver(int n, int p, int nComponents, bool isCovariance);
+
+    /**
+     * @brief Fits only the top k components with a randomized SVD of the centered data (see linAlgOps::randomizedSvd)
+     *
+     * Much faster than fit for data with many rows and columns, if only a few components are needed. The components approximate
+     * the ones of fit with the exact solvers, transform returns at most k components
+     *
+     * @param df DataFrame
+     * @param k Int, number of Principal Components to be calculated
+     * @param centerAndScale Bool, true if the input should be normalized (centered and scaled)
+     * @param oversampling Int, number of additional random vectors (see linAlgOps::randomizedSvd)
+     * @param powerIterations Int, number of power iterations (see linAlgOps::randomizedSvd)
+     * @throws std::invalid_argument If the DataFrame has fewer than two variables or k is invalid
      */
-    void fit(DataFrame& df, bool centerAndScale = false, bool svd = false, bool isCovariance = false);
+    void fitRandomized(DataFrame& df, int k, bool centerAndScale = false, int oversampling = 10, int powerIterations = 2);
 
     /**
      * @brief Projects the input data
@@ -60,11 +126,12 @@ public:
      * @brief Fits PCA to the data and transforms the input data
      * @param df DataFrame
      * @param centerAndScale Bool, true if the input should be normalized (centered and scaled). Input is ignored, if isCovariance = true
+     * @param solver PcaSolver Enum value (see fit)
      * @param isCovariance Bool, true if the df is a symmetric (covariance) matrix
      * @param dim Int, number of Principal Components to be returned
      * @return A DataFrame with Principal Components
      */
-    DataFrame fitTransform(DataFrame& df, bool centerAndScale = false, bool svd = false, bool isCovariance = false, int dim = 2);
+    DataFrame fitTransform(DataFrame& df, bool centerAndScale = false, PcaSolver solver = PcaSolver::Auto, bool isCovariance = false, int dim = 2);
 
     std::vector<double> getEigenvalues();
     std::vector<std::vector<double>> getEigenvectors();
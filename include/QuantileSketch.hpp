@@ -0,0 +1,96 @@
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+
+namespace descriptiveStatistics {
+        /**
+         * @brief Streaming quantile sketch (KLL, Karnin, Lang & Liberty) in bounded memory
+         *
+         * The values are kept in levels, a value on level h stands for 2^h values. A full level is sorted and every second value
+         * is moved to the next level. With k = 200 the rank error of a quantile is about 1%, the memory is about 3k values.
+         * As long as no level was compacted (at most max(k, exactLimit) values), the quantiles are exact.
+         * Sketches of parts of the data (e.g. from other threads or batches) can be merged. NaN values are ignored
+         */
+        class QuantileSketch {
+            private:
+                int k;
+                std::size_t exactLimit;
+                long long count = 0;
+                double minValue = std::numeric_limits<double>::infinity();
+                double maxValue = -std::numeric_limits<double>::infinity();
+                std::vector<std::vector<double>> levels;
+                std::size_t size = 0;
+                // Sum of the capacities of all levels, updated when a level is added
+                std::size_t maxSize = 0;
+                // Chooses which half of a compacted level is kept. Seeded with a constant, so that the results are reproducible
+                std::minstd_rand random;
+
+                std::size_t capacity(std::size_t level) const;
+                void addLevel();
+                // Compacts levels, until the values fit into the capacity again
+                void compress();
+
+            public:
+                /**
+                 * @brief Creates an empty sketch
+                 * @param k Accuracy parameter, the capacity of the top level
+                 * @param exactLimit Number of values, which are kept exactly before the first compaction, if larger than k
+                 * @throws std::invalid_argument If k is smaller than 8
+                 */
+                explicit QuantileSketch(int k = 200, std::size_t exactLimit = 0);
+
+                /**
+                 * @brief Adds a single value
+                 * @param val The value
+                 */
+                void add(double val);
+                /**
+                 * @brief Adds all values of a span, e.g. of a column in its storage type
+                 * @tparam T The value type
+                 * @param values Span over the values
+                 */
+                template<typename T>
+                void add(std::span<const T> values) {
+                    for (T val : values) add(static_cast<double>(val));
+                }
+                /**
+                 * @brief Merges the values of another sketch into this sketch
+                 * @param other The other sketch (its k may differ)
+                 */
+                void merge(const QuantileSketch& other);
+
+                /**
+                 * @brief Returns the q-quantile
+                 *
+                 * Exact sketches interpolate linearly between the order statistics (like the default of R and numpy),
+                 * otherwise the value with the estimated rank q * count is returned
+                 *
+                 * @param q The probability in [0, 1]
+                 * @return double value
+                 * @throws std::invalid_argument If q is not in [0, 1] or the sketch is empty
+                 */
+                double quantile(double q) const;
+                /**
+                 * @brief Returns the median (0.5-quantile)
+                 * @return double value
+                 * @throws std::invalid_argument If the sketch is empty
+                 */
+                double median() const;
+                /**
+                 * @brief Checks if the sketch still holds all values, so that the quantiles are exact
+                 * @return true if no values were compacted
+                 */
+                bool isExact() const;
+                long long getCount() const;
+                double getMin() const;
+                double getMax() const;
+        };
+}
+
+#endif // QUANTILESKETCH_H
@@ -0,0 +1,87 @@
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+#include <span>
+
+
+// Vectorized reductions (and elementwise transformations) over the native storage of a column (int, float or double), without widening the data in memory.
+// The values are converted to double in the registers and accumulated in double. The instruction set (AVX-512, AVX2 or scalar)
+// is chosen at runtime, depending on the CPU, so the same binary runs on every x86-64 machine
+namespace simdKernels {
+        enum class SimdLevel {
+            Scalar,
+            AVX2,
+            AVX512
+        };
+
+        struct MinMax {
+            double min;
+            double max;
+        };
+
+        /**
+         * @brief Returns the highest instruction set supported by the CPU (and the compiler)
+         * @return SimdLevel Enum value
+         */
+        SimdLevel detectSimdLevel();
+        /**
+         * @brief Returns the instruction set used by the kernels
+         * @return SimdLevel Enum value, initially detectSimdLevel()
+         */
+        SimdLevel getSimdLevel();
+        /**
+         * @brief Sets the instruction set used by the kernels, e.g. to compare the kernels with the scalar version
+         * @param level SimdLevel Enum value
+         * @throws std::invalid_argument If the CPU does not support the instruction set
+         */
+        void setSimdLevel(SimdLevel level);
+
+        /**
+         * @brief Sum of the values
+         * @tparam T The storage type (int, float or double, the kernels are instantiated for these types only)
+         * @param values Span over the values
+         * @return double value
+         */
+        template<typename T>
+        double sum(std::span<const T> values);
+        /**
+         * @brief Sum of the squared deviations from a center, e.g. the sum of squares around the mean
+         * @tparam T The storage type (int, float or double)
+         * @param values Span over the values
+         * @param center The center
+         * @return double value
+         */
+        template<typename T>
+        double sumSquaredDeviations(std::span<const T> values, double center);
+        /**
+         * @brief Minimum and maximum of the values
+         * @tparam T The storage type (int, float or double)
+         * @param values Span over the values, must not be empty
+         * @return MinMax of the values
+         */
+        template<typename T>
+        MinMax minMax(std::span<const T> values);
+        /**
+         * @brief Dot product of two vectors of the same length
+         * @tparam T The storage type (int, float or double)
+         * @param a Span over the first vector
+         * @param b Span over the second vector
+         * @return double value
+         * @throws std::invalid_argument If the lengths differ
+         */
+        template<typename T>
+        double dot(std::span<const T> a, std::span<const T> b);
+        /**
+         * @brief Writes (x - center) * scale for every value x to out, e.g. to standardize a column with its mean and 1 / standard deviation
+         * @tparam T The storage type (int, float or double)
+         * @param values Span over the values
+         * @param center The center, which is subtracted
+         * @param scale The factor, which is applied after subtracting the center
+         * @param out Span over the output, may be the same memory as values (for double)
+         * @throws std::invalid_argument If the lengths differ
+         */
+        template<typename T>
+        void standardize(std::span<const T> values, double center, double scale, std::span<double> out);
+}
+
+#endif // SIMDKERNELS_H
@@ -10,6 +10,26 @@ class StandardScaler {
 private:
     std::vector<double> means;
     std::vector<double> stdev;
+    // Running count, mean and M2 per column, from which means and stdev are derived
+    std::vector<descriptiveStatistics::ColumnSummary> summaries;
+
+    /**
+     * @brief Derives the means and standard deviations from the column summaries
+     */
+    void updateFromSummaries();
+    /**
+     * @brief Checks if the input fits to the fitted scaler and warns about columns, which can not be scaled
+     * @param df DataFrame
+     * @return false if the input is empty, true otherwise
+     * @throws std::runtime_error If the scaler was not fitted or the number of columns does not match
+     */
+    bool checkInput(const DataFrame& df) const;
+    /**
+     * @brief Writes the scaled columns of df to the given buffers (one per column with the number of rows of df), in parallel
+     * @param df DataFrame
+     * @param outData Pointers to the output buffers, may point to the Double columns of df itself
+     */
+    void scaleColumns(const DataFrame& df, const std::vector<double*>& outData) const;
 
 public:
     StandardScaler();
@@ -19,16 +39,50 @@ public:
      * @param df DataFrame
      */
     void fit(DataFrame& df);
+    /**
+     * @brief Updates means and standard deviations with another batch of the data
+     *
+     * The running count, mean and M2 of every column are merged with the ones of the batch (Chan et al.), so fitting the batches
+     * one after another gives the same result as fit on all of the data. Calling fit starts over
+     *
+     * @param df DataFrame with the same columns as the previous batches
+     * @throws std::invalid_argument If the DataFrame is empty or the number of columns differs from the previous batches
+     */
+    void partialFit(DataFrame& df);
+    /**
+     * @brief Merges a scaler, which was fitted on another part of the data (e.g. another shard)
+     * @param other The other StandardScaler, an unfitted scaler is ignored
+     * @throws std::invalid_argument If the number of columns differs
+     */
+    void merge(const StandardScaler& other);
     /**
      * @brief Normalizes the input data, given the means and standard deviations in fit
      * @param df DataFrame
      * @return DataFrame
      */
     DataFrame transform(DataFrame& df);
+    /**
+     * @brief Normalizes the input data in place, without allocating new columns
+     *
+     * Double columns are overwritten, Int and Float columns are replaced by Double columns with the scaled values
+     *
+     * @param df DataFrame
+     */
+    void transformInPlace(DataFrame& df);
+    /**
+     * @brief Normalizes the input data into an output DataFrame, reusing its buffers
+     *
+     * If out already has the layout of the result (e.g. from transforming the previous batch of the same size), its Double columns
+     * are overwritten without any allocation. Otherwise out is replaced by a new DataFrame
+     *
+     * @param df DataFrame
+     * @param out DataFrame, which receives the scaled data
+     */
+    void transformInto(const DataFrame& df, DataFrame& out);
     DataFrame fitTransform(DataFrame& df);
     std::vector<double> getMeans();
     std::vector<double> getStdevs();
-    bool hasFitted;
+    bool hasFitted = false;
 };
 
 #endif // STANDARDSCALER_H
@@ -0,0 +1,74 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Pool of worker threads, which is shared by the whole library (see global). Work is handed out as indices of a parallelFor,
+// idle workers take the next index of the oldest unfinished parallelFor, so long running tasks do not hold back the others
+class ThreadPool {
+    private:
+        struct Job;
+
+        std::vector<std::thread> workers;
+        std::deque<std::shared_ptr<Job>> jobs;
+        std::mutex mutex;
+        std::condition_variable workAvailable;
+        bool stopping = false;
+
+        void workerLoop();
+        // Runs tasks of the job, until all of its indices are taken
+        void runTasks(Job& job);
+
+    public:
+        /**
+         * @brief Starts a pool
+         * @param numThreads Number of threads working on a parallelFor, including the calling thread (so numThreads - 1 workers are started).
+         *                   0 uses all hardware threads
+         */
+        explicit ThreadPool(int numThreads = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Returns the number of threads working on a parallelFor, including the calling thread
+         * @return int value
+         */
+        int getNumThreads() const;
+
+        /**
+         * @brief Calls task(i) for every i in [0, nrTasks) on the workers and the calling thread and waits until all calls are finished
+         *
+         * The indices are taken dynamically one by one, so tasks should be large enough (e.g. a column or a chunk of a column) to outweigh
+         * the synchronization. A parallelFor can be called from within a task, the calling thread then works on the inner tasks as well
+         *
+         * @param nrTasks Number of tasks
+         * @param task Callable taking the index of the task
+         * @throws exception The exception of the task with the lowest index, if tasks threw (after all tasks are finished)
+         */
+        void parallelFor(int nrTasks, const std::function<void(int)>& task);
+
+        /**
+         * @brief Returns the pool used by the library, which is started on the first use with all hardware threads
+         * @return Reference to the pool
+         */
+        static ThreadPool& global();
+        /**
+         * @brief Replaces the pool used by the library by a pool with the given number of threads
+         *
+         * Must not be called while the library uses the pool (e.g. from within a task)
+         *
+         * @param numThreads Number of threads including the calling thread, 0 uses all hardware threads
+         */
+        static void setGlobalNumThreads(int numThreads);
+};
+
+#endif // THREADPOOL_H
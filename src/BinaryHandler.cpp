@@ -0,0 +1,214 @@
+#include "BinaryHandler.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "MappedFile.hpp"
+
+namespace binaryHandler {
+
+    namespace {
+        constexpr char magic[8] = {'M', 'I', 'N', 'I', 'M', 'L', 'D', 'F'};
+        constexpr std::uint32_t formatVersion = 1;
+        // Written in the native byte order, to detect files written on a machine with another byte order
+        constexpr std::uint32_t byteOrderMark = 0x01020304;
+        constexpr std::uint32_t flagRowNames = 1;
+        constexpr std::uint64_t bufferAlignment = 64;
+
+        // Fixed part of the header: magic, version, byte order mark, nr. rows, nr. cols, flags
+        constexpr std::uint64_t fixedHeaderSize = 8 + 4 + 4 + 8 + 4 + 4;
+        // Per column: type, length of the name, offset of the buffer (followed by the name)
+        constexpr std::uint64_t columnEntrySize = 4 + 4 + 8;
+
+        std::uint64_t alignUp(std::uint64_t offset) {
+            return (offset + bufferAlignment - 1) / bufferAlignment * bufferAlignment;
+        }
+
+        std::uint64_t bytesPerValue(ColumnType type) {
+            switch (type) {
+                case ColumnType::Int: return sizeof(int);
+                case ColumnType::Float: return sizeof(float);
+                case ColumnType::Double: return sizeof(double);
+                default: throw std::runtime_error("Unknown ColumnType");
+            }
+        }
+
+        template<typename T>
+        void append(std::string& buffer, T value) {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        // Reads values from the mapped header and checks, that nothing is read behind the end of the file
+        class HeaderReader {
+            private:
+                const MappedFile& file;
+                const std::string& filename;
+                std::uint64_t pos = 0;
+
+            public:
+                HeaderReader(const MappedFile& file, const std::string& filename) : file(file), filename(filename) {}
+
+                void require(std::uint64_t bytes) const {
+                    if (bytes > file.size() || pos > file.size() - bytes) {
+                        throw std::runtime_error(filename + " is truncated or not a valid binary DataFrame file");
+                    }
+                }
+
+                template<typename T>
+                T read() {
+                    require(sizeof(T));
+                    T value;
+                    std::memcpy(&value, file.data() + pos, sizeof(T));
+                    pos += sizeof(T);
+                    return value;
+                }
+
+                std::string readString(std::uint32_t length) {
+                    require(length);
+                    std::string value(file.data() + pos, length);
+                    pos += length;
+                    return value;
+                }
+        };
+
+        template<typename T>
+        Column mappedColumn(const std::shared_ptr<const MappedFile>& file, std::uint64_t offset, std::uint64_t nrRows) {
+            const T* values = reinterpret_cast<const T*>(file->data() + offset);
+            return Column::fromExternal<T>(std::span<const T>(values, nrRows), file);
+        }
+    }
+
+    void save(DataFrame& df, const std::string& filename) {
+        std::ofstream outFile(filename, std::ios::binary);
+        if (!outFile.is_open()) {
+            throw std::runtime_error("Unable to open file: " + filename);
+        }
+
+        auto [nrRows, nrCols] = df.getDim();
+        std::vector<std::string> colNames = df.getColNames();
+        bool withRowNames = df.hasRowNames();
+
+        // The header size is needed first, since the column entries hold the offsets of the buffers
+        std::uint64_t headerSize = fixedHeaderSize;
+        for (const std::string& colName : colNames) {
+            headerSize += columnEntrySize + colName.size();
+        }
+        std::vector<std::string> rowNames;
+        if (withRowNames) {
+            rowNames = df.getRowNames();
+            for (const std::string& rowName : rowNames) {
+                headerSize += 4 + rowName.size();
+            }
+        }
+
+        std::string header;
+        header.reserve(headerSize);
+        header.append(magic, sizeof(magic));
+        append<std::uint32_t>(header, formatVersion);
+        append<std::uint32_t>(header, byteOrderMark);
+        append<std::uint64_t>(header, nrRows);
+        append<std::uint32_t>(header, nrCols);
+        append<std::uint32_t>(header, withRowNames ? flagRowNames : 0);
+
+        std::vector<std::uint64_t> offsets(nrCols);
+        std::uint64_t offset = headerSize;
+        for (int col = 0; col < nrCols; ++col) {
+            ColumnType type = df.getColumnType(col);
+            offsets[col] = alignUp(offset);
+            offset = offsets[col] + bytesPerValue(type) * nrRows;
+
+            append<std::uint32_t>(header, static_cast<std::uint32_t>(type));
+            append<std::uint32_t>(header, colNames[col].size());
+            append<std::uint64_t>(header, offsets[col]);
+            header.append(colNames[col]);
+        }
+        for (const std::string& rowName : rowNames) {
+            append<std::uint32_t>(header, rowName.size());
+            header.append(rowName);
+        }
+        outFile.write(header.data(), header.size());
+
+        // The column buffers are written directly from the column storage
+        std::uint64_t written = header.size();
+        const char padding[bufferAlignment] = {};
+        for (int col = 0; col < nrCols; ++col) {
+            outFile.write(padding, offsets[col] - written);
+            df.getColumn(col).visit([&](auto data) {
+                outFile.write(reinterpret_cast<const char*>(data.data()), data.size_bytes());
+                written = offsets[col] + data.size_bytes();
+            });
+        }
+
+        if (!outFile) {
+            throw std::runtime_error("Failed to write file: " + filename);
+        }
+    }
+
+    DataFrame load(const std::string& filename) {
+        if (!std::filesystem::exists(filename)) {
+            throw std::runtime_error(filename + " does not exist");
+        }
+
+        auto file = std::make_shared<const MappedFile>(filename);
+        HeaderReader reader(*file, filename);
+
+        if (reader.readString(sizeof(magic)) != std::string(magic, sizeof(magic))) {
+            throw std::runtime_error(filename + " is not a binary DataFrame file");
+        }
+        if (reader.read<std::uint32_t>() != formatVersion) {
+            throw std::runtime_error(filename + " has an unsupported version of the binary format");
+        }
+        if (reader.read<std::uint32_t>() != byteOrderMark) {
+            throw std::runtime_error(filename + " was written with a different byte order");
+        }
+        std::uint64_t nrRows = reader.read<std::uint64_t>();
+        std::uint32_t nrCols = reader.read<std::uint32_t>();
+        std::uint32_t flags = reader.read<std::uint32_t>();
+        if (nrRows > INT_MAX || nrCols > INT_MAX) {
+            throw std::runtime_error(filename + " has more rows or columns than a DataFrame can hold");
+        }
+
+        std::vector<std::pair<std::string, Column>> colData;
+        colData.reserve(nrCols);
+        for (std::uint32_t col = 0; col < nrCols; ++col) {
+            std::uint32_t typeValue = reader.read<std::uint32_t>();
+            std::uint32_t nameLength = reader.read<std::uint32_t>();
+            std::uint64_t offset = reader.read<std::uint64_t>();
+            std::string name = reader.readString(nameLength);
+
+            if (typeValue > static_cast<std::uint32_t>(ColumnType::Double)) {
+                throw std::runtime_error(filename + " has an unknown type for column " + name);
+            }
+            ColumnType type = static_cast<ColumnType>(typeValue);
+            std::uint64_t bytes = bytesPerValue(type) * nrRows;
+            if (offset % bufferAlignment != 0 || offset > file->size() || bytes > file->size() - offset) {
+                throw std::runtime_error(filename + " has an invalid buffer for column " + name);
+            }
+
+            switch (type) {
+                case ColumnType::Int: colData.emplace_back(name, mappedColumn<int>(file, offset, nrRows)); break;
+                case ColumnType::Float: colData.emplace_back(name, mappedColumn<float>(file, offset, nrRows)); break;
+                default: colData.emplace_back(name, mappedColumn<double>(file, offset, nrRows)); break;
+            }
+        }
+
+        std::vector<std::string> rowNames;
+        if (flags & flagRowNames) {
+            rowNames.reserve(nrRows);
+            for (std::uint64_t row = 0; row < nrRows; ++row) {
+                std::uint32_t length = reader.read<std::uint32_t>();
+                rowNames.push_back(reader.readString(length));
+            }
+        }
+
+        if (colData.empty()) {
+            return DataFrame();
+        }
+        return DataFrame(std::move(colData), std::move(rowNames));
+    }
+
+}
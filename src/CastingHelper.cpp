@@ -8,11 +8,11 @@ namespace castingHelper {
         std::pair<int, int> dims = df.getDim();
         Eigen::MatrixXd mat(dims.first, dims.second);
 
-        for (unsigned int i = 0; i < dims.second; ++i) {
-            std::vector<double> col = df.getColumn(i).getDataAsDouble();
-            for (unsigned int j = 0; j < dims.first; ++j) {
-                mat(j,i) = col[j];
-            }
+        for (int i = 0; i < dims.second; ++i) {
+            df.getColumn(i).visit([&](auto data) {
+                using T = typename decltype(data)::value_type;
+                mat.col(i) = Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(data.data(), dims.first).template cast<double>();
+            });
         }
         return(mat);
     }
@@ -37,12 +37,12 @@ namespace castingHelper {
             }
         }
 
+        // The columns are allocated once and filled with a copy of the (column major) matrix column
         for (int j = 0; j < cols; j++) {
-            std::vector<double> colData(rows);
-            colsData.emplace_back(finalColNames[j], Column(ColumnType::Double));
-            for (int i = 0; i < rows; i++) {
-                colsData.at(j).second.addValueFromDouble(mat(i, j));
-            }
+            Column col(ColumnType::Double);
+            col.resize(rows);
+            Eigen::Map<Eigen::VectorXd>(col.getSpan<double>().data(), rows) = mat.col(j);
+            colsData.emplace_back(finalColNames[j], std::move(col));
         }
 
         return(DataFrame(colsData));
@@ -1,122 +1,601 @@
 #include "CsvHandler.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include "MappedFile.hpp"
+#include "ThreadPool.hpp"
+
 namespace csvHandler {
 
-    DataFrame fromCSV(const std::string& filename, bool hasRowNames, char delimiter) {
-        if (!std::filesystem::exists(filename)) {
-            throw std::runtime_error(filename + " does not exist");
-        }
-    
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            throw std::runtime_error("Could not open file: " + filename);
+    namespace {
+        constexpr std::uint64_t lowBytes = 0x0101010101010101ULL;
+        constexpr std::uint64_t highBits = 0x8080808080808080ULL;
+
+        // Marks the bytes of the word which are zero (exact for the lowest zero byte, which is the only one used)
+        std::uint64_t zeroBytes(std::uint64_t word) {
+            return (word - lowBytes) & ~word & highBits;
         }
-    
-        std::string line;
-        std::vector<std::string> colNames;
-        std::vector<std::pair<std::string, Column>> colData;
-        std::vector<std::string> rowNames;
-    
-        if (std::getline(file, line)) {
-            std::stringstream ss(line);
-            std::string token;
-            bool isFirst = true;
-    
-            while (std::getline(ss, token, delimiter)) {
-                auto start = token.find_first_not_of(" \t\r\n");
-                auto end = token.find_last_not_of(" \t\r\n");
-                token = (start == std::string::npos) ? "" : token.substr(start, end - start + 1);
-    
-                if (hasRowNames && isFirst) {
-                    isFirst = false;
-                    continue;
+
+        // Finds the end of the field starting at pos, i.e. the next delimiter or newline, by testing 8 bytes at a time
+        const char* findFieldEnd(const char* pos, const char* end, char delimiter) {
+            if constexpr (std::endian::native == std::endian::little) {
+                const std::uint64_t delimiterWord = lowBytes * static_cast<unsigned char>(delimiter);
+                const std::uint64_t newlineWord = lowBytes * static_cast<unsigned char>('\n');
+                while (end - pos >= 8) {
+                    std::uint64_t word;
+                    std::memcpy(&word, pos, sizeof(word));
+                    std::uint64_t hits = zeroBytes(word ^ delimiterWord) | zeroBytes(word ^ newlineWord);
+                    if (hits != 0) return pos + (std::countr_zero(hits) / 8);
+                    pos += 8;
                 }
-    
-                colNames.push_back(token);
-                colData.emplace_back(token, Column(ColumnType::Double));
             }
+            while (pos < end && *pos != delimiter && *pos != '\n') ++pos;
+            return pos;
         }
-    
-        int rowIdx = 0;
-        while (std::getline(file, line)) {
-            std::stringstream ss(line);
-            std::string value;
-            int colIdx = 0;
+
+        const char* findLineEnd(const char* pos, const char* end) {
+            const void* newline = std::memchr(pos, '\n', end - pos);
+            return newline ? static_cast<const char*>(newline) : end;
+        }
+
+        std::string_view trim(std::string_view token) {
+            auto start = token.find_first_not_of(" \t\r\n");
+            if (start == std::string_view::npos) return {};
+            auto end = token.find_last_not_of(" \t\r\n");
+            return token.substr(start, end - start + 1);
+        }
+
+        double parseValue(std::string_view token, int rowIdx) {
+            std::string_view value = trim(token);
+            // from_chars does not accept a leading '+'
+            if (value.size() > 1 && value[0] == '+' && value[1] != '-') value.remove_prefix(1);
+            double val = 0;
+            auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), val);
+            if (ec != std::errc() || ptr != value.data() + value.size() || value.empty()) {
+                throw std::runtime_error("Failed to convert value: '" + std::string(token) + "' at row " + std::to_string(rowIdx));
+            }
+            return val;
+        }
+
+        std::vector<std::string> parseHeader(std::string_view line, bool hasRowNames, char delimiter) {
+            std::vector<std::string> colNames;
+            const char* pos = line.data();
+            const char* end = line.data() + line.size();
             bool isFirst = true;
-            std::string rowName;
-    
-            while (std::getline(ss, value, delimiter)) {
-                if (hasRowNames && isFirst) {
-                    rowName = value;
-                    isFirst = false;
-                    continue;
+            while (pos < end) {
+                const char* fieldEnd = findFieldEnd(pos, end, delimiter);
+                if (!(hasRowNames && isFirst)) {
+                    colNames.emplace_back(trim(std::string_view(pos, fieldEnd - pos)));
                 }
-    
-                if (colIdx >= static_cast<int>(colNames.size())) {
-                    throw std::runtime_error("Too many values in row " + std::to_string(rowIdx));
+                isFirst = false;
+                pos = fieldEnd + 1;
+            }
+            return colNames;
+        }
+
+        // Parses the data rows in [begin, end) directly into the pre-sized column buffers, starting at the row firstRow.
+        // fieldBuffers has one entry per field of a line (without the row name), fields with a nullptr buffer are skipped without conversion.
+        // rowNumberOffset is added to the row numbers in error messages, if the buffers do not start at the first row of the file.
+        // Returns the number of parsed rows
+        int parseRows(const char* begin, const char* end, bool hasRowNames, char delimiter, const std::vector<double*>& fieldBuffers,
+                      std::vector<std::string>* rowNames, int firstRow, int rowNumberOffset = 0) {
+            const int nrCols = static_cast<int>(fieldBuffers.size());
+            int rowIdx = firstRow;
+            const char* pos = begin;
+
+            while (pos < end) {
+                const char* lineEnd = findLineEnd(pos, end);
+                int colIdx = 0;
+                bool isFirst = true;
+
+                while (pos < lineEnd) {
+                    const char* fieldEnd = findFieldEnd(pos, lineEnd, delimiter);
+                    std::string_view token(pos, fieldEnd - pos);
+                    pos = fieldEnd + 1;
+
+                    if (hasRowNames && isFirst) {
+                        rowNames->emplace_back(token);
+                        isFirst = false;
+                        continue;
+                    }
+
+                    if (colIdx >= nrCols) {
+                        throw std::runtime_error("Too many values in row " + std::to_string(rowIdx + rowNumberOffset));
+                    }
+                    if (fieldBuffers[colIdx] != nullptr) {
+                        fieldBuffers[colIdx][rowIdx] = parseValue(token, rowIdx + rowNumberOffset);
+                    }
+                    ++colIdx;
                 }
-    
-                std::stringstream val_stream(value);
-                double val;
-                val_stream >> val;
-    
-                if (val_stream.fail()) {
-                    throw std::runtime_error("Failed to convert value: '" + value + "' at row " + std::to_string(rowIdx));
+
+                if (colIdx != nrCols) {
+                    throw std::runtime_error("Too few values in row " + std::to_string(rowIdx + rowNumberOffset));
                 }
-    
-                colData.at(colIdx).second.addValueFromDouble(val);
-                ++colIdx;
+
+                pos = lineEnd + 1;
+                ++rowIdx;
             }
-    
-            if (colIdx != static_cast<int>(colNames.size())) {
-                throw std::runtime_error("Too few values in row " + std::to_string(rowIdx));
+            return rowIdx - firstRow;
+        }
+
+        // Returns the position behind the next nrLines lines (or end, if there are fewer lines)
+        const char* skipLines(const char* begin, const char* end, int nrLines) {
+            const char* pos = begin;
+            for (int line = 0; line < nrLines && pos < end; ++line) {
+                pos = findLineEnd(pos, end);
+                if (pos < end) ++pos;
             }
-    
-            if (hasRowNames) {
-                rowNames.push_back(rowName);
+            return pos;
+        }
+
+        // Resolves the column selection of the options to the positions of the selected fields in a line
+        std::vector<int> selectFields(const std::vector<std::string>& colNames, const CsvReadOptions& options) {
+            if (!options.columns.empty() && !options.columnIndices.empty()) {
+                throw std::invalid_argument("Columns can either be selected by name or by index, not both");
+            }
+
+            std::vector<int> fields;
+            if (!options.columns.empty()) {
+                for (const std::string& name : options.columns) {
+                    auto it = std::find(colNames.begin(), colNames.end(), name);
+                    if (it == colNames.end()) throw std::invalid_argument("Could not find a column with name: " + name);
+                    fields.push_back(static_cast<int>(it - colNames.begin()));
+                }
+            } else if (!options.columnIndices.empty()) {
+                for (int index : options.columnIndices) {
+                    if (index < 0 || index >= static_cast<int>(colNames.size())) {
+                        throw std::invalid_argument("Could not find a column with index: " + std::to_string(index));
+                    }
+                    fields.push_back(index);
+                }
             } else {
-                rowNames.push_back("R" + std::to_string(rowIdx));
+                for (int i = 0; i < static_cast<int>(colNames.size()); ++i) fields.push_back(i);
             }
-    
-            ++rowIdx;
+            return fields;
         }
-    
-        file.close();
-    
-        return DataFrame(colData, rowNames);
+
+        void checkOptions(const CsvReadOptions& options) {
+            if (options.skipRows < 0) throw std::invalid_argument("Number of rows to skip cannot be negative");
+            if (options.maxRows < -1) throw std::invalid_argument("Maximal number of rows has to be -1 (all rows) or at least 0");
+            if (!(options.floatTolerance >= 0.0)) throw std::invalid_argument("Float tolerance cannot be negative");
+        }
+
+        bool fitsInt(double val) {
+            return(val >= std::numeric_limits<int>::min() && val <= std::numeric_limits<int>::max() && val == std::trunc(val));
+        }
+
+        bool fitsFloat(double val, double tolerance) {
+            float narrowed = static_cast<float>(val);
+            if (std::isnan(val)) return true;
+            // Values outside of the float range become inf, which is only exact for inf itself
+            if (std::isinf(narrowed)) return(narrowed == val);
+            return(std::abs(static_cast<double>(narrowed) - val) <= tolerance * std::abs(val));
+        }
+
+        // Copies the values into a column of type T, returns false (and leaves target incomplete), if a value does not fit
+        template<typename T, typename Fits>
+        bool narrowInto(std::span<const double> values, Column& target, Fits fits) {
+            target.resize(static_cast<int>(values.size()));
+            std::span<T> out = target.getSpan<T>();
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                if (!fits(values[i])) return false;
+                out[i] = static_cast<T>(values[i]);
+            }
+            return true;
+        }
+
+        // Returns the column in the narrowest type, which holds all of its values (see CsvReadOptions::inferTypes).
+        // The type is inferred from the sample rows and then verified on all rows while the values are copied
+        Column narrowColumn(const Column& column, const CsvReadOptions& options) {
+            std::span<const double> values = column.getSpan<double>();
+            if (values.empty()) return column;
+
+            std::size_t sampleSize = values.size();
+            if (options.inferenceSampleRows >= 0) sampleSize = std::min(sampleSize, static_cast<std::size_t>(options.inferenceSampleRows));
+            std::span<const double> sample = values.first(sampleSize);
+
+            auto fitsTolerance = [&](double val) { return fitsFloat(val, options.floatTolerance); };
+            bool sampleInt = std::all_of(sample.begin(), sample.end(), fitsInt);
+            bool sampleFloat = sampleInt || std::all_of(sample.begin(), sample.end(), fitsTolerance);
+
+            if (sampleInt) {
+                Column narrowed(ColumnType::Int);
+                if (narrowInto<int>(values, narrowed, fitsInt)) return narrowed;
+            }
+            if (sampleFloat) {
+                Column narrowed(ColumnType::Float);
+                if (narrowInto<float>(values, narrowed, fitsTolerance)) return narrowed;
+            }
+            return column;
+        }
+
+        // Number of lines in [begin, end), a last line without newline is counted as well
+        int countLines(const char* begin, const char* end) {
+            int lines = 0;
+            for (const char* pos = begin; pos < end; pos = findLineEnd(pos, end) + 1) {
+                ++lines;
+            }
+            return lines;
+        }
+
+        int numThreadsFor(int requestedThreads, std::size_t bytes) {
+            // Small inputs are not worth the overhead of starting threads
+            constexpr std::size_t minBytesPerThread = 1 << 20;
+            int numThreads = requestedThreads > 0 ? requestedThreads : ThreadPool::global().getNumThreads();
+            int maxUseful = static_cast<int>(bytes / minBytesPerThread) + 1;
+            return std::max(1, std::min(numThreads, maxUseful));
+        }
+
+        // Splits [begin, end) into nrChunks byte ranges of similar size, every range (except the first) starts directly behind a newline
+        std::vector<const char*> splitIntoChunks(const char* begin, const char* end, int nrChunks) {
+            std::vector<const char*> bounds = {begin};
+            const std::size_t chunkSize = (end - begin) / nrChunks;
+            for (int chunk = 1; chunk < nrChunks; ++chunk) {
+                const char* bound = std::max(bounds.back(), begin + chunk * chunkSize);
+                bound = findLineEnd(bound, end);
+                bound = bound < end ? bound + 1 : end;
+                if (bound > bounds.back() && bound < end) bounds.push_back(bound);
+            }
+            bounds.push_back(end);
+            return bounds;
+        }
+
+        // Calls task(i) for i in [0, nrTasks) on the thread pool of the library
+        void runParallel(int nrTasks, const std::function<void(int)>& task) {
+            ThreadPool::global().parallelFor(nrTasks, task);
+        }
+    }
+
+    namespace {
+        // Longest output of std::to_chars for a double in its shortest round trip form
+        constexpr std::size_t maxValueChars = 32;
+
+        template<typename T>
+        char* formatValue(char* out, const void* data, int row) {
+            return std::to_chars(out, out + maxValueChars, static_cast<const T*>(data)[row]).ptr;
+        }
+
+        // Typed access to the values of a column, without going through the type erased interface for every value
+        struct ColumnWriter {
+            const void* data;
+            char* (*format)(char*, const void*, int);
+        };
+
+        // Formats the rows [firstRow, lastRow) as lines of the Csv file into out
+        void formatRows(const DataFrame& df, const std::vector<ColumnWriter>& writers, int firstRow, int lastRow,
+                        const CsvWriteOptions& options, std::vector<char>& out) {
+            const std::size_t maxRowChars = writers.size() * (maxValueChars + 1) + 1;
+            std::size_t used = 0;
+            for (int row = firstRow; row < lastRow; ++row) {
+                std::string rowName = options.includeRowNames ? df.getRowName(row) : std::string();
+                if (out.size() - used < maxRowChars + rowName.size() + 1) {
+                    out.resize(std::max(2 * out.size(), used + maxRowChars + rowName.size() + 1));
+                }
+
+                char* pos = out.data() + used;
+                if (options.includeRowNames) {
+                    pos = std::copy(rowName.begin(), rowName.end(), pos);
+                    *pos++ = options.delimiter;
+                }
+                for (std::size_t col = 0; col < writers.size(); ++col) {
+                    pos = writers[col].format(pos, writers[col].data, row);
+                    *pos++ = options.delimiter;
+                }
+                // The last delimiter is replaced by the line end
+                if (!writers.empty() || options.includeRowNames) --pos;
+                *pos++ = '\n';
+                used = pos - out.data();
+            }
+            out.resize(used);
+        }
+    }
+
+    DataFrame fromCSV(const std::string& filename, bool hasRowNames, char delimiter) {
+        CsvReadOptions options;
+        options.hasRowNames = hasRowNames;
+        options.delimiter = delimiter;
+        return fromCSV(filename, options);
+    }
+
+    DataFrame fromCSV(const std::string& filename, const CsvReadOptions& options) {
+        if (!std::filesystem::exists(filename)) {
+            throw std::runtime_error(filename + " does not exist");
+        }
+
+        MappedFile file(filename);
+        const char* begin = file.data();
+        const char* end = file.data() + file.size();
+
+        std::vector<std::string> colNames;
+        std::vector<std::pair<std::string, Column>> colData;
+        std::vector<std::string> rowNames;
+
+        if (begin == end) {
+            return DataFrame(colData, rowNames);
+        }
+
+        checkOptions(options);
+        const char* headerEnd = findLineEnd(begin, end);
+        colNames = parseHeader(std::string_view(begin, headerEnd - begin), options.hasRowNames, options.delimiter);
+        std::vector<int> fields = selectFields(colNames, options);
+        const char* dataBegin = headerEnd < end ? headerEnd + 1 : end;
+
+        // Only the byte range of the requested rows is parsed
+        const char* rangeBegin = skipLines(dataBegin, end, options.skipRows);
+        const char* rangeEnd = options.maxRows >= 0 ? skipLines(rangeBegin, end, options.maxRows) : end;
+
+        // Split the data into byte ranges, which start at the beginning of a line
+        std::vector<const char*> chunkBounds = splitIntoChunks(rangeBegin, rangeEnd, numThreadsFor(options.numThreads, rangeEnd - rangeBegin));
+        const int nrChunks = static_cast<int>(chunkBounds.size()) - 1;
+
+        // Every line is a row, so counting the lines per chunk gives the position of the first row of every chunk
+        std::vector<int> firstRows(nrChunks + 1, 0);
+        runParallel(nrChunks, [&](int chunk) {
+            firstRows[chunk + 1] = countLines(chunkBounds[chunk], chunkBounds[chunk + 1]);
+        });
+        for (int chunk = 0; chunk < nrChunks; ++chunk) {
+            firstRows[chunk + 1] += firstRows[chunk];
+        }
+        const int nrRows = firstRows[nrChunks];
+
+        std::vector<double*> buffers(colNames.size(), nullptr);
+        colData.reserve(fields.size());
+        for (int field : fields) {
+            colData.emplace_back(colNames[field], Column(ColumnType::Double));
+            colData.back().second.resize(nrRows);
+            buffers[field] = colData.back().second.getSpan<double>().data();
+        }
+
+        // Every chunk writes its rows directly to their final position. Errors are reported for the first faulty chunk in file order,
+        // the row numbers in the messages are global, since every chunk knows the position of its first row
+        std::vector<std::vector<std::string>> chunkRowNames(nrChunks);
+        std::vector<std::exception_ptr> errors(nrChunks);
+        runParallel(nrChunks, [&](int chunk) {
+            try {
+                parseRows(chunkBounds[chunk], chunkBounds[chunk + 1], options.hasRowNames, options.delimiter, buffers,
+                          &chunkRowNames[chunk], firstRows[chunk], options.skipRows);
+            } catch (...) {
+                errors[chunk] = std::current_exception();
+            }
+        });
+        for (const std::exception_ptr& error : errors) {
+            if (error) std::rethrow_exception(error);
+        }
+
+        if (options.inferTypes) {
+            for (auto& [colName, column] : colData) {
+                column = narrowColumn(column, options);
+            }
+        }
+
+        if (options.hasRowNames) {
+            rowNames.reserve(nrRows);
+            for (auto& names : chunkRowNames) {
+                std::move(names.begin(), names.end(), std::back_inserter(rowNames));
+            }
+        }
+
+        return DataFrame(std::move(colData), std::move(rowNames));
     }
     
 
-    void toCSV(DataFrame& df, const std::string& filename, bool includeRowNames, char delimiter) {
-        std::ofstream outFile(filename);
+    void toCSV(const DataFrame& df, const std::string& filename, bool includeRowNames, char delimiter) {
+        CsvWriteOptions options;
+        options.includeRowNames = includeRowNames;
+        options.delimiter = delimiter;
+        toCSV(df, filename, options);
+    }
+
+    void toCSV(const DataFrame& df, const std::string& filename, const CsvWriteOptions& options) {
+        std::ofstream outFile(filename, std::ios::binary);
         if (!outFile.is_open()) {
             throw std::runtime_error("Unable to open file: " + filename);
         }
 
-        auto colNames = df.getColNames();
-        auto rowNames = df.getRowNames();
-        int numRows = df.getDim().first;
-        int numCols = df.getDim().second;
+        std::vector<std::string> colNames = df.getColNames();
+        const int numRows = df.getDim().first;
+        const int numCols = df.getDim().second;
 
-        if (includeRowNames) outFile << "RowNames,";
-        for (unsigned int i = 0; i < colNames.size(); ++i) {
-            outFile << colNames[i];
-            if (i != colNames.size() - 1) outFile << delimiter;
+        std::string header = options.includeRowNames ? "RowNames" + std::string(1, options.delimiter) : "";
+        for (int i = 0; i < numCols; ++i) {
+            header += colNames[i];
+            if (i != numCols - 1) header += options.delimiter;
         }
-        outFile << "\n";
+        header += '\n';
+        outFile.write(header.data(), header.size());
 
-        for (int row = 0; row < numRows; ++row) {
-            if (includeRowNames) {
-                outFile << (row < rowNames.size() ? rowNames[row] : "") << delimiter;
-            }
-            for (int col = 0; col < numCols; ++col) {
-                outFile << df.getColumn(col).getDataAtAsDouble(row);
-                if (col != numCols - 1) outFile << delimiter;
+        std::vector<ColumnWriter> writers;
+        writers.reserve(numCols);
+        for (int col = 0; col < numCols; ++col) {
+            writers.push_back(df.getColumn(col).visit([](auto values) {
+                using T = typename decltype(values)::value_type;
+                return ColumnWriter{values.data(), &formatValue<std::remove_const_t<T>>};
+            }));
+        }
+
+        // Rows are formatted in blocks of about 1 MB. The threads format one block each, the blocks are then written in order
+        constexpr std::size_t blockChars = 1 << 20;
+        const std::size_t estimatedRowChars = numCols * 20 + (options.includeRowNames ? 8 : 0) + 1;
+        const int blockRows = static_cast<int>(std::max<std::size_t>(1, blockChars / estimatedRowChars));
+        const int nrBlocks = (numRows + blockRows - 1) / blockRows;
+        const int numThreads = std::min(numThreadsFor(options.numThreads, numRows * estimatedRowChars), std::max(1, nrBlocks));
+
+        std::vector<std::vector<char>> buffers(numThreads);
+        for (int firstBlock = 0; firstBlock < nrBlocks; firstBlock += numThreads) {
+            const int blocks = std::min(numThreads, nrBlocks - firstBlock);
+            runParallel(blocks, [&](int i) {
+                const int firstRow = (firstBlock + i) * blockRows;
+                formatRows(df, writers, firstRow, std::min(numRows, firstRow + blockRows), options, buffers[i]);
+            });
+            for (int i = 0; i < blocks; ++i) {
+                outFile.write(buffers[i].data(), buffers[i].size());
             }
-            outFile << "\n";
         }
 
         outFile.close();
+        if (!outFile) {
+            throw std::runtime_error("Could not write file: " + filename);
+        }
+    }
+
+
+    CsvBatchReader::CsvBatchReader(const std::string& filename, int batchSize, const CsvReadOptions& options)
+        : batchSize(batchSize), options(options) {
+        if (batchSize <= 0) {
+            throw std::invalid_argument("Batch size has to be greater than 0");
+        }
+        checkOptions(options);
+        if (!std::filesystem::exists(filename)) {
+            throw std::runtime_error(filename + " does not exist");
+        }
+        file.open(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file: " + filename);
+        }
+
+        startReadahead();
+
+        // Read blocks until the header line is complete
+        const void* newline = nullptr;
+        while ((pos == buffer.size() || (newline = std::memchr(buffer.data() + pos, '\n', buffer.size() - pos)) == nullptr) && refill()) {}
+
+        const char* begin = buffer.data() + pos;
+        const char* end = buffer.data() + buffer.size();
+        const char* headerEnd = newline ? static_cast<const char*>(newline) : end;
+        std::vector<std::string> fileColNames = parseHeader(std::string_view(begin, headerEnd - begin), options.hasRowNames, options.delimiter);
+        pos += (headerEnd < end ? headerEnd + 1 : end) - begin;
+
+        nrFields = static_cast<int>(fileColNames.size());
+        selectedFields = selectFields(fileColNames, options);
+        for (int field : selectedFields) {
+            colNames.push_back(fileColNames[field]);
+            columns.emplace_back(ColumnType::Double);
+        }
+
+        // Skipped rows are only searched for their line end
+        int skipped = 0;
+        while (skipped < options.skipRows) {
+            const char* lineStart = buffer.data() + pos;
+            const char* lineEnd = pos < buffer.size() ? findLineEnd(lineStart, buffer.data() + buffer.size()) : lineStart;
+            if (lineEnd < buffer.data() + buffer.size()) {
+                pos += lineEnd + 1 - lineStart;
+                ++skipped;
+            } else if (!refill()) {
+                pos = buffer.size();
+                break;
+            }
+        }
+    }
+
+    CsvBatchReader::~CsvBatchReader() {
+        // The readahead thread uses the file and the readahead buffer, so it has to finish first
+        if (readahead.valid()) readahead.wait();
+    }
+
+    void CsvBatchReader::startReadahead() {
+        readahead = std::async(std::launch::async, [this]() {
+            readaheadBuffer.resize(blockSize);
+            file.read(readaheadBuffer.data(), blockSize);
+            return static_cast<std::size_t>(file.gcount());
+        });
+    }
+
+    bool CsvBatchReader::refill() {
+        if (!readahead.valid()) return false;
+        std::size_t bytesRead = readahead.get();
+
+        // Keep the unparsed rest (an incomplete line) at the front of the buffer and append the new block behind it
+        buffer.erase(buffer.begin(), buffer.begin() + pos);
+        pos = 0;
+        buffer.insert(buffer.end(), readaheadBuffer.begin(), readaheadBuffer.begin() + bytesRead);
+
+        if (bytesRead == 0) return false;
+        startReadahead();
+        return true;
+    }
+
+    bool CsvBatchReader::next(DataFrame& batch) {
+        // Releases the columns of the previous batch, so that their buffers can be reused, if nobody else holds them
+        batch = DataFrame();
+
+        int rowsToRead = batchSize;
+        if (options.maxRows >= 0) rowsToRead = std::min(rowsToRead, options.maxRows - rowsRead);
+        if (rowsToRead <= 0) return false;
+
+        std::vector<double*> buffers(nrFields, nullptr);
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            Column& column = columns[i];
+            // A column still shared with an old batch is not copied, but replaced by a new buffer
+            if (column.isShared()) column = Column(ColumnType::Double);
+            column.resize(rowsToRead);
+            buffers[selectedFields[i]] = column.getSpan<double>().data();
+        }
+        rowNames.clear();
+
+        const int rowNumberOffset = rowsRead + options.skipRows;
+        int rows = 0;
+        while (rows < rowsToRead) {
+            const char* begin = buffer.data() + pos;
+            const char* end = buffer.data() + buffer.size();
+
+            // Only complete lines are parsed, an incomplete line at the end of the buffer waits for the next block
+            const char* cut = begin;
+            int lines = 0;
+            while (lines < rowsToRead - rows && cut < end) {
+                const void* newline = std::memchr(cut, '\n', end - cut);
+                if (newline == nullptr) break;
+                cut = static_cast<const char*>(newline) + 1;
+                ++lines;
+            }
+
+            if (lines == 0) {
+                if (refill()) continue;
+                // End of file: the rest is the last line, which has no newline at its end
+                begin = buffer.data() + pos;
+                end = buffer.data() + buffer.size();
+                if (begin < end) {
+                    rows += parseRows(begin, end, options.hasRowNames, options.delimiter, buffers, &rowNames, rows, rowNumberOffset);
+                    pos = buffer.size();
+                }
+                break;
+            }
+
+            rows += parseRows(begin, cut, options.hasRowNames, options.delimiter, buffers, &rowNames, rows, rowNumberOffset);
+            pos += cut - begin;
+        }
+
+        if (rows == 0) return false;
+
+        std::vector<std::pair<std::string, Column>> colData;
+        colData.reserve(columns.size());
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            columns[i].resize(rows);
+            colData.emplace_back(colNames[i], columns[i]);
+        }
+        batch = DataFrame(std::move(colData), rowNames);
+        rowsRead += rows;
+        return true;
+    }
+
+    std::vector<std::string> CsvBatchReader::getColNames() const {
+        return colNames;
+    }
+
+    int CsvBatchReader::getRowsRead() const {
+        return rowsRead;
     }
 
-}
\ No newline at end of file
+}
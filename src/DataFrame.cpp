@@ -1,38 +1,31 @@
 #include "DataFrame.hpp"
 
+#include <charconv>
+
 DataFrame::DataFrame() : nrCols(0), nrRows(0) {}
 
 // Standard way of creating a DataFrame: Create pairs of columns and column names and additional if wanted add row names
 DataFrame::DataFrame(std::vector<std::pair<std::string, Column>> columns, std::vector<std::string> rowNames) {
     if(columns.empty()) throw std::invalid_argument("For Dataframe initialization some data is needed");
 
-    int i = 0;
-    for (const auto& [name, values] : columns) {
-        if(i == 0) {
-            nrRows = values.size();
-        } else {
-            if (nrRows != values.size()) {
-                throw std::invalid_argument("All columns must have the same number of elements.");
-            }
+    nrRows = columns.front().second.size();
+    this->columns.reserve(columns.size());
+    columnNames.reserve(columns.size());
+    for (auto& [name, values] : columns) {
+        if (nrRows != values.size()) {
+            throw std::invalid_argument("All columns must have the same number of elements.");
+        }
+        if (!colNameToIndex.emplace(name, static_cast<int>(columnNames.size())).second) {
+            throw std::invalid_argument("Column names must be unique, but " + name + " exists more than once.");
         }
         columnNames.push_back(name);
-        colIndexToName[i] = name;
-        this->columns.emplace(name, values);
-        ++i;
+        this->columns.push_back(std::move(values));
     }
 
+    // Without row names, the rows are labeled implicitly by their position (see getRowName)
     if(!rowNames.empty()) {
         if(nrRows != rowNames.size()) throw std::invalid_argument("Number of rows does not match number of row names");
-        this->rowNames = rowNames;
-        for (int j = 0; j < nrRows; j++) {
-            rowNameToIndex[rowNames[j]] = j;
-        }
-    } else {
-        for (int j = 0; j < nrRows; j++) {
-            rowNames.push_back("R" + std::to_string(j));
-            rowNameToIndex[rowNames[j]] = j;
-        }
-        this->rowNames = rowNames;
+        this->rowNames = std::move(rowNames);
     }
     nrCols = this->columns.size();
 }
@@ -66,179 +59,230 @@ DataFrame::DataFrame(std::initializer_list<std::pair<std::string, std::vector<do
     }())
     {}
 
-void DataFrame::checkIndexOutOfRange(const std::span<int>& indices, bool row) {
+void DataFrame::checkIndexOutOfRange(const std::span<int>& indices, bool row) const {
+    int limit = row ? nrRows : nrCols;
     for (int val : indices) {
-        int limit = 0;
-        if(row) limit = nrRows;
-        else limit = nrCols;
         if (val < 0 || val >= limit) {
             if(row) {
-                throw std::invalid_argument("Could not find a row with index: " + val);
+                throw std::invalid_argument("Could not find a row with index: " + std::to_string(val));
             } else {
-                throw std::invalid_argument("Could not find a column with index: " + val);
+                throw std::invalid_argument("Could not find a column with index: " + std::to_string(val));
             }
         }
     }
 }
 
-void DataFrame::checkIndexOutOfRange(int index, bool row) {
+void DataFrame::checkIndexOutOfRange(int index, bool row) const {
     std::array<int, 1> tmp = {index};
     checkIndexOutOfRange(std::span(tmp), row);
 }
 
-bool DataFrame::empty() {
+int DataFrame::getColumnIndex(const std::string& col) const {
+    auto it = colNameToIndex.find(col);
+    if (it == colNameToIndex.end()) throw std::invalid_argument("Could not find a column with name: " + col);
+    return it->second;
+}
+
+int DataFrame::getRowIndex(const std::string& row) const {
+    if(rowNames.empty()) {
+        // Implicit row names are "R" + index, so the index can be parsed from the name without any lookup table
+        int index = -1;
+        if(row.size() > 1 && row[0] == 'R') {
+            auto [ptr, ec] = std::from_chars(row.data() + 1, row.data() + row.size(), index);
+            if(ec != std::errc() || ptr != row.data() + row.size() || std::to_string(index) != row.substr(1)) index = -1;
+        }
+        if(index < 0 || index >= nrRows) throw std::invalid_argument("Could not find a row with name: " + row);
+        return index;
+    }
+
+    if(!rowIndexBuilt) {
+        rowNameToIndex.clear();
+        rowNameToIndex.reserve(rowNames.size());
+        for(int i = 0; i < static_cast<int>(rowNames.size()); i++) {
+            rowNameToIndex.emplace(rowNames[i], i);
+        }
+        rowIndexBuilt = true;
+    }
+    auto it = rowNameToIndex.find(row);
+    if(it == rowNameToIndex.end()) throw std::invalid_argument("Could not find a row with name: " + row);
+    return it->second;
+}
+
+void DataFrame::materializeRowNames() {
+    if(!rowNames.empty() || nrRows == 0) return;
+    rowNames.reserve(nrRows);
+    for(int i = 0; i < nrRows; i++) {
+        rowNames.push_back("R" + std::to_string(i));
+    }
+    rowIndexBuilt = false;
+}
+
+bool DataFrame::empty() const {
     if(nrRows == 0 || nrCols == 0) return(true);
     else return(false);
 }
 
 std::vector<double> DataFrame::getRow(int row) {
-    if(row < 0 || row >= rowNames.size()) throw std::invalid_argument("Row index: " + std::to_string(row) + " does not exist");
+    if(row < 0 || row >= nrRows) throw std::invalid_argument("Row index: " + std::to_string(row) + " does not exist");
     std::vector<double> rowVec;
-    for(const auto& [name, col] : columns) {
+    rowVec.reserve(nrCols);
+    for(const Column& col : columns) {
         rowVec.push_back(col.getDataAtAsDouble(row));
     }
     return rowVec;
 }
 
 std::vector<double> DataFrame::getRow(std::string row) {
-    return getRow(rowNameToIndex[row]);
+    return getRow(getRowIndex(row));
 }
 
-Column DataFrame::getColumn(int col) {
+const Column& DataFrame::getColumn(int col) const {
     checkIndexOutOfRange(col, false);
-    return(columns.at(colIndexToName[col]));
-
+    return(columns[col]);
 }
 
-Column DataFrame::getColumn(std::string col) {
-    if (!(columns.find(col) != columns.end())) throw std::invalid_argument("Could not find a column with name: " + col);
-    return columns.at(col);
+const Column& DataFrame::getColumn(std::string col) const {
+    return columns[getColumnIndex(col)];
 }
 
 ColumnType DataFrame::getColumnType(int col) {
     checkIndexOutOfRange(col, false);
-    return columns.at(colIndexToName[col]).getType();
+    return columns[col].getType();
 }
 
 ColumnType DataFrame::getColumnType(std::string col) {
-    if (!(columns.find(col) != columns.end())) throw std::invalid_argument("Could not find a column with name: " + col);
-    return columns.at(col).getType();
+    return columns[getColumnIndex(col)].getType();
 }
 
 double DataFrame::get(int row, int col) {
     checkIndexOutOfRange(col, false);
     checkIndexOutOfRange(row, true);
-    return columns.at(colIndexToName[col]).getDataAtAsDouble(row);
+    return columns[col].getDataAtAsDouble(row);
 }
 
 double DataFrame::get(int row, std::string col) {
-    if (!(columns.find(col) != columns.end())) throw std::invalid_argument("Could not find a column with name: " + col);
+    int colIdx = getColumnIndex(col);
     checkIndexOutOfRange(row, true);
-    return columns.at(col).getDataAtAsDouble(row);
+    return columns[colIdx].getDataAtAsDouble(row);
 }
 
 double DataFrame::get(std::string row, std::string col) {
-    if (!(columns.find(col) != columns.end())) throw std::invalid_argument("Could not find a column with name: " + col);
-    return columns.at(col).getDataAtAsDouble(rowNameToIndex[row]);
+    return columns[getColumnIndex(col)].getDataAtAsDouble(getRowIndex(row));
 }
 
 double DataFrame::get(std::string row, int col) {
     checkIndexOutOfRange(col, false);
-    return columns.at(colIndexToName[col]).getDataAtAsDouble(rowNameToIndex[row]);
+    return columns[col].getDataAtAsDouble(getRowIndex(row));
 }
 
 DataFrame DataFrame::get(std::span<int> rows, std::span<std::string> cols) {
+    std::vector<int> colIndices;
+    colIndices.reserve(cols.size());
+    for (const std::string& col : cols) {
+        colIndices.push_back(getColumnIndex(col));
+    }
+    return(get(rows, std::span<int>(colIndices)));
+}
+
+DataFrame DataFrame::get(std::span<int> rows, std::span<int> cols) {
     checkIndexOutOfRange(rows, true);
+    checkIndexOutOfRange(cols, false);
+
+    // If all rows are selected in their original order, the subset can share the column storage with this DataFrame
+    bool allRows = rows.size() == static_cast<size_t>(nrRows);
+    for (unsigned int i = 0; allRows && i < rows.size(); i++) {
+        if (rows[i] != static_cast<int>(i)) allRows = false;
+    }
 
     DataFrame dfNew;
-    for (std::string col : cols) {
-        if (columns.find(col) == columns.end()) throw std::invalid_argument("Could not find a column with name: " + col);
+    for (int col : cols) {
+        const Column& column = columns[col];
+        if (allRows) {
+            dfNew.addColumn(column, columnNames[col]);
+            continue;
+        }
         std::vector<double> new_col(rows.size());
         for(unsigned int i = 0; i < rows.size(); i++) {
-            new_col[i] = columns.at(col).getDataAtAsDouble(rows[i]);
+            new_col[i] = column.getDataAtAsDouble(rows[i]);
         }
-        dfNew.addColumn(new_col, col, columns.at(col).getType());
+        dfNew.addColumn(new_col, columnNames[col], column.getType());
     }
-    
-    std::vector<std::string> newRowNames(rows.size());
-    std::vector<std::string> oldRowNames = getRowNames();
 
-    for(unsigned int i = 0; i < rows.size(); i++) {
-        newRowNames[i] = oldRowNames[rows[i]];
+    // A subset with all rows keeps implicit row names implicit, otherwise the rows keep their labels from this DataFrame
+    if(!allRows || hasRowNames()) {
+        std::vector<std::string> newRowNames(rows.size());
+        for(unsigned int i = 0; i < rows.size(); i++) {
+            newRowNames[i] = getRowName(rows[i]);
+        }
+        dfNew.setRowNames(newRowNames);
     }
-    dfNew.setRowNames(newRowNames);
 
     return(dfNew);
 }
 
-DataFrame DataFrame::get(std::span<int> rows, std::span<int> cols) {
-    checkIndexOutOfRange(rows, true);
-    checkIndexOutOfRange(cols, false);
-
-    std::vector<std::string> newColNames;
-    for(int col : cols) {
-        newColNames.push_back(colIndexToName[col]);
-    }
-    return(get(rows, newColNames));
-}
-
 DataFrame DataFrame::get(std::span<std::string> rows, std::span<int> cols) {
-    checkIndexOutOfRange(cols, false);
-    std::vector<std::string> newColnames;
-    for(int col : cols) {
-        newColnames.push_back(colIndexToName[col]);
-    }
     std::vector<int> newRowIndices;
     for(std::string row : rows) {
-        newRowIndices.push_back(rowNameToIndex[row]);
+        newRowIndices.push_back(getRowIndex(row));
     }
-    return(get(newRowIndices, newColnames));
+    return(get(newRowIndices, cols));
 }
 
 DataFrame DataFrame::get(std::span<std::string> rows, std::span<std::string> cols) {
     std::vector<int> newRowIndices;
     for(std::string row : rows) {
-        newRowIndices.push_back(rowNameToIndex[row]);
+        newRowIndices.push_back(getRowIndex(row));
     }
     return(get(newRowIndices, cols));
 }
 
 void DataFrame::set(double val, int row, std::string col) {
+    int colIdx = getColumnIndex(col);
     checkIndexOutOfRange(row, true);
-    columns.at(col).setAt(val, row); 
+    columns[colIdx].setAt(val, row);
+    touch();
 }
 
 void DataFrame::set(double val, int row, int col) {
     checkIndexOutOfRange(row, true);
     checkIndexOutOfRange(col, false);
-    set(val, row, colIndexToName[col]);
+    columns[col].setAt(val, row);
+    touch();
 }
 
 void DataFrame::set(double val, std::string row, int col) {
-    checkIndexOutOfRange(col, false);
-    set(val, rowNameToIndex[row], colIndexToName[col]);
+    set(val, getRowIndex(row), col);
 }
 
 void DataFrame::set(double val, std::string row, std::string col) {
-    set(val, rowNameToIndex[row], col);
+    set(val, getRowIndex(row), col);
 }
 
 void DataFrame::addColumn(std::vector<double>& newCol, const std::string& colName, ColumnType type) {
-    if(nrRows == 0) nrRows = newCol.size();
+    Column col(type);
+    col.fillFromDouble(newCol);
+    addColumn(col, colName);
+}
+
+void DataFrame::addColumn(const Column& newCol, const std::string& colName) {
+    if(nrCols == 0 && nrRows == 0) nrRows = newCol.size();
     else if(newCol.size() != nrRows) throw std::invalid_argument("New column has to have the same number of rows, as the data frame");
-    if (std::find(columnNames.begin(), columnNames.end(), colName) != columnNames.end()) {
+    if (colNameToIndex.find(colName) != colNameToIndex.end()) {
         std::cerr << "Warning: Column with name " + colName + " already exists. If you want to overwrite it, please use the set function" << std::endl;
         return;
     }
-    columns.emplace(colName, Column(type));
-    columns.at(colName).fillFromDouble(newCol);
+    colNameToIndex.emplace(colName, nrCols);
+    columns.push_back(newCol);
     columnNames.push_back(colName);
-    colIndexToName[nrCols] = colName;
     nrCols++;
-    if(rowNames.empty()) {
-        for(unsigned int i = 0; i < nrRows; i++)
-        rowNames.push_back("R" + std::to_string(i));
-    }
+    touch();
+}
+
+void DataFrame::setColumn(int col, const Column& newCol) {
+    checkIndexOutOfRange(col, false);
+    if(newCol.size() != nrRows) throw std::invalid_argument("New column has to have the same number of rows, as the data frame");
+    columns[col] = newCol;
+    touch();
 }
 
 void DataFrame::addRow(std::vector<double>& newRow, const std::string& rowName) {
@@ -246,125 +290,127 @@ void DataFrame::addRow(std::vector<double>& newRow, const std::string& rowName)
     if(newRow.size() != nrCols) throw std::invalid_argument("New row has to have the same number of cols, as the data frame");
 
     for(int i = 0; i < nrCols; i++) {
-        columns.at(colIndexToName[i]).addValueFromDouble(newRow[i]);
+        columns[i].addValueFromDouble(newRow[i]);
     }
 
-    if(rowName.empty()) {
-        std::string defaultName = "R" + std::to_string(nrRows);
-        rowNames.push_back(defaultName);
-        rowNameToIndex[defaultName] = nrRows;
-    } else {
-        rowNames.push_back(rowName);
-        rowNameToIndex[rowName] = nrRows;
+    // As long as the row names are implicit, a row without a name needs no bookkeeping
+    if(!rowName.empty() || hasRowNames()) {
+        materializeRowNames();
+        rowNames.push_back(rowName.empty() ? "R" + std::to_string(nrRows) : rowName);
+        if(rowIndexBuilt) rowNameToIndex[rowNames.back()] = nrRows;
     }
     nrRows++;
+    touch();
 }
 
 void DataFrame::concatenate(DataFrame df, bool keepFirstOnly) {
     if(df.getDim().first != nrRows) throw std::invalid_argument("Both dataframes need to have the same number of rows");
 
-    std::vector<std::string> colnamesOther = df.getColNames();
-    std::string newColname;
-    for (const auto& colnameOther : colnamesOther) {
-        if (!(columns.find(colnameOther) != columns.end())) {
-            newColname = colnameOther;
-        } else {
-            if(!keepFirstOnly) {
-                newColname = colnameOther + "_2";
-            }
-        }
-        if(!newColname.empty()) {
-            std::vector<double> colData = df.getColumn(colnameOther).getDataAsDouble();
-            addColumn(colData, newColname, df.getColumn(colnameOther).getType());
+    for (int i = 0; i < df.nrCols; i++) {
+        const std::string& colnameOther = df.columnNames[i];
+        if (colNameToIndex.find(colnameOther) == colNameToIndex.end()) {
+            addColumn(df.columns[i], colnameOther);
+        } else if(!keepFirstOnly) {
+            addColumn(df.columns[i], colnameOther + "_2");
         }
     }
 }
 
 void DataFrame::dropColumn(std::string& col) {
-    auto it = columns.find(col);
-    if (it != columns.end()) {
-        columns.erase(it);
-    } else {
+    auto it = colNameToIndex.find(col);
+    if (it == colNameToIndex.end()) {
         throw std::invalid_argument("Column '" + col + "' does not exist.");
     }
-
-    auto name_it = std::find(columnNames.begin(), columnNames.end(), col);
-    if (name_it != columnNames.end()) {
-        columnNames.erase(name_it);
-    }
-
-    colIndexToName.clear();
-    for (size_t i = 0; i < columnNames.size(); ++i) {
-        colIndexToName[i] = columnNames[i];
-    }
-
-    nrCols = static_cast<int>(columnNames.size());
+    dropColumn(it->second);
 }
 
 void DataFrame::dropColumn(int col) {
     checkIndexOutOfRange(col, false);
-    dropColumn(colIndexToName[col]);
+    colNameToIndex.erase(columnNames[col]);
+    columns.erase(columns.begin() + col);
+    columnNames.erase(columnNames.begin() + col);
+    // Only the columns behind the dropped one change their position
+    for (int i = col; i < static_cast<int>(columnNames.size()); ++i) {
+        colNameToIndex[columnNames[i]] = i;
+    }
+    nrCols = static_cast<int>(columns.size());
+    touch();
 }
 
 void DataFrame::dropRow(int row) {
     checkIndexOutOfRange(row, true);
-    for (auto& [key, col] : columns) {
+    for (Column& col : columns) {
         col.deleteAt(row);
     }
+    // The remaining rows keep their labels, so implicit names have to be made explicit here
+    materializeRowNames();
     rowNames.erase(rowNames.begin() + row);
-
-    std::string foundKey = "";
-    for (const auto& [key, value] : rowNameToIndex) {
-        if (value == row) {
-            foundKey = key;
-            break;
-        }
-    }
-    if(!foundKey.empty()) rowNameToIndex.erase(foundKey);
+    rowIndexBuilt = false;
     nrRows--;
+    touch();
 }
 
 void DataFrame::dropRow(std::string& row) {
-    dropRow(rowNameToIndex[row]);
+    dropRow(getRowIndex(row));
+}
+
+std::vector<std::string> DataFrame::getRowNames() const {
+    if(hasRowNames()) return rowNames;
+    std::vector<std::string> names;
+    names.reserve(nrRows);
+    for(int i = 0; i < nrRows; i++) {
+        names.push_back(getRowName(i));
+    }
+    return names;
 }
 
-std::vector<std::string> DataFrame::getRowNames() {
-    return rowNames;
+std::string DataFrame::getRowName(int row) const {
+    checkIndexOutOfRange(row, true);
+    if(hasRowNames()) return rowNames[row];
+    return "R" + std::to_string(row);
 }
 
-std::vector<std::string> DataFrame::getColNames() {
+bool DataFrame::hasRowNames() const {
+    return !rowNames.empty();
+}
+
+std::vector<std::string> DataFrame::getColNames() const {
     return columnNames;
 }
 
-std::pair<int, int> DataFrame::getDim() {
+std::pair<int, int> DataFrame::getDim() const {
     return std::make_pair(nrRows, nrCols);
 }
 
+std::uint64_t DataFrame::getVersion() const {
+    return version;
+}
+
+void DataFrame::touch() {
+    version = Column::newVersion();
+}
+
 void DataFrame::setRowNames(std::vector<std::string> rowNames) {
     if(nrRows != rowNames.size()) throw std::invalid_argument("New row names has to have the same number of rows, as the data frame");
-    this->rowNames = rowNames;
+    this->rowNames = std::move(rowNames);
     rowNameToIndex.clear();
-    int i = 0;
-    for(std::string rowName : rowNames) {
-        rowNameToIndex[rowName] = i;
-        ++i;
-    }
+    rowIndexBuilt = false;
+    touch();
 }
 
 void DataFrame::setColNames(std::vector<std::string> columnNames) {
     if(this->columnNames.size() != columnNames.size()) throw std::invalid_argument("New column names has to have the same number of rows, as the data frame");
-    this->columnNames = columnNames;
-
-    std::unordered_map<std::string, Column> newColMapping;
-    std::unordered_map<int, std::string> newColIndexToName;
 
-    for(int i = 0; i < columnNames.size(); i++) {
-        newColIndexToName[i] = columnNames[i];
-        newColMapping.emplace(columnNames[i], Column(columns.at(colIndexToName[i]).getType()));
-        newColMapping.at(columnNames[i]).fillFromDouble(columns.at(colIndexToName[i]).getDataAsDouble());
+    std::unordered_map<std::string, int> newColNameToIndex;
+    for(int i = 0; i < static_cast<int>(columnNames.size()); i++) {
+        if (!newColNameToIndex.emplace(columnNames[i], i).second) {
+            throw std::invalid_argument("Column names must be unique, but " + columnNames[i] + " exists more than once.");
+        }
     }
-    columns = std::move(newColMapping);
-    colIndexToName = std::move(newColIndexToName);
+    // Only the names change, the columns stay at their position
+    this->columnNames = std::move(columnNames);
+    colNameToIndex = std::move(newColNameToIndex);
+    touch();
 }
 
 void DataFrame::print() {
@@ -376,13 +422,10 @@ void DataFrame::print() {
     std::cout << std::string(12 + columnNames.size() * 11, '-') << "\n";
 
     for (int row = 0; row < nrRows; ++row) {
-        std::cout << std::setw(10) << rowNames[row] << " | ";
-        for (int col = 0; col < static_cast<int>(columnNames.size()); ++col) {
-            std::cout << std::setw(10) << columns.at(columnNames[col]).getDataAtAsDouble(row) << " ";
+        std::cout << std::setw(10) << getRowName(row) << " | ";
+        for (const Column& col : columns) {
+            std::cout << std::setw(10) << col.getDataAtAsDouble(row) << " ";
         }
         std::cout << "\n";
     }
 }
-
-
-
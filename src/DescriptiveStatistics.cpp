@@ -1,34 +1,367 @@
 #include "DescriptiveStatistics.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "SimdKernels.hpp"
+#include "ThreadPool.hpp"
+
 namespace descriptiveStatistics {
 
-    Eigen::MatrixXd covariancesEigen(DataFrame& df) {
+    // Memoized statistics of a DataFrame. The results are stored by the versions of the columns they were computed from,
+    // so they are invalidated by every modification of a column and stay valid for unmodified columns
+    class StatisticsCache {
+        public:
+            std::mutex mutex;
+            std::unordered_map<std::uint64_t, ColumnSummary> summaries;
+            // Column versions of the memoized covariance matrix, in column order
+            std::vector<std::uint64_t> covarianceVersions;
+            Eigen::MatrixXd covariance;
+    };
+
+    StatisticsCache& cacheOf(const DataFrame& df) {
+        // Created on first use, while the DataFrame is only read. The cache is shared by unmodified copies of the DataFrame
+        static std::mutex creationMutex;
+        std::lock_guard<std::mutex> lock(creationMutex);
+        if (!df.statisticsCache) df.statisticsCache = std::make_shared<StatisticsCache>();
+        return *df.statisticsCache;
+    }
+
+    namespace {
+        // Number of values per block in summarize, small enough that the second pass over a block is served from the L1 cache
+        constexpr std::size_t summaryBlockSize = 2048;
+        // Number of values per task on the thread pool for per column kernels
+        constexpr std::size_t parallelChunkSize = 1 << 16;
+        // Number of values per row tile in addCoMoments (8 MB)
+        constexpr std::size_t covarianceTileValues = 1 << 20;
+
+        struct ColumnChunk {
+            std::size_t col;
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        // Splits the columns into chunks of at most parallelChunkSize values, which are the tasks for the thread pool
+        std::vector<ColumnChunk> splitColumns(const std::vector<const Column*>& cols) {
+            std::vector<ColumnChunk> chunks;
+            for (std::size_t col = 0; col < cols.size(); ++col) {
+                const std::size_t size = cols[col]->size();
+                for (std::size_t begin = 0; begin < size; begin += parallelChunkSize) {
+                    chunks.push_back({col, begin, std::min(size, begin + parallelChunkSize)});
+                }
+            }
+            return chunks;
+        }
+
+        // Adds the co-moments of the centered data to the lower triangle of coMoments. The centered data is processed in tiles of rows,
+        // every tile is added as a rank-k update. The tile size bounds the additional memory to about covarianceTileValues doubles
+        void addCoMoments(const DataFrame& df, const Eigen::VectorXd& meansVec, Eigen::MatrixXd& coMoments) {
+            const int n = df.getDim().first;
+            const int p = df.getDim().second;
+            const int tileRows = std::max(64, static_cast<int>(covarianceTileValues / p));
+            Eigen::MatrixXd tile;
+
+            for (int firstRow = 0; firstRow < n; firstRow += tileRows) {
+                const int rows = std::min(tileRows, n - firstRow);
+                tile.resize(rows, p);
+                for (int col = 0; col < p; ++col) {
+                    df.getColumn(col).visit([&](auto data) {
+                        for (int k = 0; k < rows; ++k) {
+                            tile(k, col) = data[firstRow + k] - meansVec(col);
+                        }
+                    });
+                }
+                coMoments.selfadjointView<Eigen::Lower>().rankUpdate(tile.transpose());
+            }
+        }
+
+        // Summarizes the values [begin, end) of a column, block by block. If sketch is given, the blocks are added to it as well
+        ColumnSummary summarizeRange(const Column& col, std::size_t begin, std::size_t end, QuantileSketch* sketch) {
+            return col.visit([begin, end, sketch](auto data) {
+                ColumnSummary summary;
+                for (std::size_t blockBegin = begin; blockBegin < end; blockBegin += summaryBlockSize) {
+                    auto block = data.subspan(blockBegin, std::min(summaryBlockSize, end - blockBegin));
+
+                    // The kernels read the values in their storage type, the further passes over the block are served from the cache
+                    ColumnSummary blockSummary;
+                    blockSummary.count = static_cast<long long>(block.size());
+                    blockSummary.mean = simdKernels::sum(block) / block.size();
+                    blockSummary.m2 = simdKernels::sumSquaredDeviations(block, blockSummary.mean);
+                    simdKernels::MinMax minMax = simdKernels::minMax(block);
+                    blockSummary.min = minMax.min;
+                    blockSummary.max = minMax.max;
+                    if (sketch) sketch->add(block);
+
+                    summary.merge(blockSummary);
+                }
+                return summary;
+            });
+        }
+
+        // Summarizes the columns on the thread pool. Every column is split into chunks, which are summarized in parallel and merged in order,
+        // so that a single long column is processed by all threads and the result does not depend on the number of threads.
+        // If sketches is given, it is filled with one quantile sketch per column, built in the same scan
+        std::vector<ColumnSummary> summarizeColumns(const std::vector<const Column*>& cols, std::vector<QuantileSketch>* sketches = nullptr,
+                                                    const QuantileSketch& emptySketch = QuantileSketch()) {
+            std::vector<ColumnChunk> chunks = splitColumns(cols);
+            std::vector<ColumnSummary> chunkSummaries(chunks.size());
+            std::vector<QuantileSketch> chunkSketches(sketches ? chunks.size() : 0, emptySketch);
+            ThreadPool::global().parallelFor(static_cast<int>(chunks.size()), [&](int i) {
+                const ColumnChunk& chunk = chunks[i];
+                chunkSummaries[i] = summarizeRange(*cols[chunk.col], chunk.begin, chunk.end, sketches ? &chunkSketches[i] : nullptr);
+            });
+
+            std::vector<ColumnSummary> summaries(cols.size());
+            if (sketches) sketches->assign(cols.size(), emptySketch);
+            for (std::size_t i = 0; i < chunks.size(); ++i) {
+                summaries[chunks[i].col].merge(chunkSummaries[i]);
+                if (sketches) (*sketches)[chunks[i].col].merge(chunkSketches[i]);
+            }
+            return summaries;
+        }
+
+        std::vector<std::uint64_t> columnVersions(const DataFrame& df) {
+            std::vector<std::uint64_t> versions;
+            for (int col = 0; col < df.getDim().second; ++col) {
+                versions.push_back(df.getColumn(col).getVersion());
+            }
+            return versions;
+        }
+
+        Eigen::VectorXd columnMeans(const DataFrame& df) {
+            std::vector<ColumnSummary> summaries = describe(df);
+            Eigen::VectorXd meansVec(summaries.size());
+            for (std::size_t col = 0; col < summaries.size(); ++col) meansVec(col) = summaries[col].mean;
+            return meansVec;
+        }
+
+        // Correlations over the rows, in which both columns of a pair are not NaN. Per tile of rows, the values (shifted and with NaN set to 0)
+        // and their validity masks are multiplied, so that the sums of every pair over its complete rows result from a few GEMMs
+        Eigen::MatrixXd pairwiseCorrelations(const DataFrame& df) {
+            const int n = df.getDim().first;
+            const int p = df.getDim().second;
+
+            // Shifting every column by one of its values avoids the cancellation of large sums of squares
+            Eigen::VectorXd shifts = Eigen::VectorXd::Zero(p);
+            for (int col = 0; col < p; ++col) {
+                df.getColumn(col).visit([&](auto data) {
+                    for (auto val : data) {
+                        if (!std::isnan(static_cast<double>(val))) {
+                            shifts(col) = val;
+                            break;
+                        }
+                    }
+                });
+            }
+
+            Eigen::MatrixXd pairCounts = Eigen::MatrixXd::Zero(p, p);  // Complete rows per pair
+            Eigen::MatrixXd products = Eigen::MatrixXd::Zero(p, p);    // Sum of x_i * x_j
+            Eigen::MatrixXd sums = Eigen::MatrixXd::Zero(p, p);        // Sum of x_i over the complete rows of (i, j)
+            Eigen::MatrixXd squares = Eigen::MatrixXd::Zero(p, p);     // Sum of x_i^2 over the complete rows of (i, j)
+
+            const int tileRows = std::max(64, static_cast<int>(covarianceTileValues / p));
+            Eigen::MatrixXd values, masks;
+            for (int firstRow = 0; firstRow < n; firstRow += tileRows) {
+                const int rows = std::min(tileRows, n - firstRow);
+                values.resize(rows, p);
+                masks.resize(rows, p);
+                for (int col = 0; col < p; ++col) {
+                    df.getColumn(col).visit([&](auto data) {
+                        for (int k = 0; k < rows; ++k) {
+                            const double val = data[firstRow + k];
+                            const bool valid = !std::isnan(val);
+                            values(k, col) = valid ? val - shifts(col) : 0.0;
+                            masks(k, col) = valid ? 1.0 : 0.0;
+                        }
+                    });
+                }
+                pairCounts.selfadjointView<Eigen::Lower>().rankUpdate(masks.transpose());
+                products.selfadjointView<Eigen::Lower>().rankUpdate(values.transpose());
+                sums.noalias() += values.transpose() * masks;
+                squares.noalias() += values.cwiseAbs2().transpose() * masks;
+            }
+
+            Eigen::MatrixXd correlationMat(p, p);
+            for (int j = 0; j < p; ++j) {
+                for (int i = j; i < p; ++i) {
+                    const double count = pairCounts(i, j);
+                    double correlation = std::numeric_limits<double>::quiet_NaN();
+                    if (count >= 2) {
+                        const double coMoment = products(i, j) - sums(i, j) * sums(j, i) / count;
+                        const double m2I = squares(i, j) - sums(i, j) * sums(i, j) / count;
+                        const double m2J = squares(j, i) - sums(j, i) * sums(j, i) / count;
+                        correlation = coMoment / std::sqrt(m2I * m2J);
+                        if (i == j && m2I > 0) correlation = 1.0;
+                    }
+                    correlationMat(i, j) = correlation;
+                    correlationMat(j, i) = correlation;
+                }
+            }
+            return correlationMat;
+        }
+
+        // Symmetric matrix as DataFrame, with the names as column and row names
+        DataFrame matrixToDataFrame(const Eigen::MatrixXd& mat, const std::vector<std::string>& names) {
+            DataFrame result;
+            for (std::size_t i = 0; i < names.size(); ++i) {
+                std::vector<double> colVec(mat.col(i).data(), mat.col(i).data() + mat.col(i).size());
+                result.addColumn(colVec, names[i]);
+            }
+            result.setRowNames(names);
+            return result;
+        }
+
+        constexpr char accumulatorMagic[8] = {'M', 'I', 'N', 'I', 'M', 'L', 'C', 'A'};
+        constexpr std::uint32_t accumulatorVersion = 1;
+        // Written in the native byte order, to detect blobs written on a machine with another byte order
+        constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+        template<typename T>
+        void append(std::string& buffer, T value) {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        T read(std::string_view blob, std::size_t& pos) {
+            if (sizeof(T) > blob.size() - pos) throw std::runtime_error("Covariance accumulator blob is truncated");
+            T value;
+            std::memcpy(&value, blob.data() + pos, sizeof(T));
+            pos += sizeof(T);
+            return value;
+        }
+    }
+
+    Eigen::MatrixXd covariancesEigen(const DataFrame& df) {
         if (df.getDim().first == 0 || df.getDim().second < 1) {
             throw std::invalid_argument("Cannot calculate Covariance of fewer than 2 variables.");
         }
 
-        std::vector<std::string> colnames = df.getColNames();
         auto dims = df.getDim();
         int n = dims.first;
-        Eigen::MatrixXd covarianceMat(dims.second, dims.second);
+        int p = dims.second;
 
-        std::vector<double> meansVec = means(df);
+        StatisticsCache& cache = cacheOf(df);
+        std::vector<std::uint64_t> versions = columnVersions(df);
+        {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            if (cache.covarianceVersions == versions) return cache.covariance;
+        }
 
-        for (unsigned int i = 0; i < colnames.size(); i++) {
-            auto column1 = df.getColumn(colnames[i]).getDataAsDouble();
-            for (unsigned int j = 0; j <= i; j++) {  // only compute lower triangle
-                auto column2 = df.getColumn(colnames[j]).getDataAsDouble();
-                double covSum = 0;
-                for (int k = 0; k < n; ++k) {
-                    covSum += (column1[k] - meansVec[i]) * (column2[k] - meansVec[j]);
-                }
-                double cov = covSum / (n - 1);
-                covarianceMat(i, j) = cov;
-                covarianceMat(j, i) = cov;
+        Eigen::VectorXd meansVec = columnMeans(df);
+
+        Eigen::MatrixXd coMoments = Eigen::MatrixXd::Zero(p, p);
+        addCoMoments(df, meansVec, coMoments);
+
+        Eigen::MatrixXd covarianceMat = coMoments.selfadjointView<Eigen::Lower>();
+        covarianceMat /= (n - 1);
+
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.covarianceVersions = std::move(versions);
+        cache.covariance = covarianceMat;
+        return covarianceMat;
+    }
+
+    void ColumnSummary::add(double val) {
+        ++count;
+        double delta = val - mean;
+        mean += delta / count;
+        m2 += delta * (val - mean);
+        min = std::min(min, val);
+        max = std::max(max, val);
+    }
+
+    void ColumnSummary::merge(const ColumnSummary& other) {
+        if (other.count == 0) return;
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        long long n = count + other.count;
+        double delta = other.mean - mean;
+        mean += delta * (static_cast<double>(other.count) / n);
+        m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / n);
+        count = n;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+
+    double ColumnSummary::variance() const {
+        if (count < 2) return std::numeric_limits<double>::quiet_NaN();
+        return m2 / (count - 1);
+    }
+
+    double ColumnSummary::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    ColumnSummary summarize(const Column& col) {
+        return summarizeColumns({&col})[0];
+    }
+
+    std::vector<ColumnSummary> describe(const DataFrame& df) {
+        const int p = df.getDim().second;
+        StatisticsCache& cache = cacheOf(df);
+        std::vector<std::uint64_t> versions = columnVersions(df);
+
+        // Only the columns without a memoized summary are scanned
+        std::vector<ColumnSummary> summaries(p);
+        std::vector<int> missing;
+        {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            for (int col = 0; col < p; ++col) {
+                auto it = cache.summaries.find(versions[col]);
+                if (it != cache.summaries.end()) summaries[col] = it->second;
+                else missing.push_back(col);
             }
         }
+        if (missing.empty()) return summaries;
 
-        return covarianceMat;
+        std::vector<const Column*> cols;
+        for (int col : missing) {
+            cols.push_back(&df.getColumn(col));
+        }
+        std::vector<ColumnSummary> computed = summarizeColumns(cols);
+
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        for (std::size_t i = 0; i < missing.size(); ++i) {
+            summaries[missing[i]] = computed[i];
+            cache.summaries[versions[missing[i]]] = computed[i];
+        }
+        // Summaries of outdated column versions are dropped, once they outnumber the current ones
+        if (cache.summaries.size() > 2 * versions.size()) {
+            std::unordered_set<std::uint64_t> current(versions.begin(), versions.end());
+            std::erase_if(cache.summaries, [&current](const auto& entry) { return !current.contains(entry.first); });
+        }
+        return summaries;
+    }
+
+    std::vector<ColumnSummary> describe(const DataFrame& df, std::vector<QuantileSketch>& sketches, int k, std::size_t exactLimit) {
+        std::vector<const Column*> cols;
+        for (int col = 0; col < df.getDim().second; ++col) {
+            cols.push_back(&df.getColumn(col));
+        }
+        return summarizeColumns(cols, &sketches, QuantileSketch(k, exactLimit));
+    }
+
+    std::vector<double> quantiles(const DataFrame& df, double q, int k, std::size_t exactLimit) {
+        if (df.getDim().first == 0 || df.getDim().second == 0) {
+            throw std::invalid_argument("Cannot calculate quantiles on empty DataFrame.");
+        }
+
+        std::vector<QuantileSketch> sketches;
+        describe(df, sketches, k, exactLimit);
+        std::vector<double> result;
+        for (const QuantileSketch& sketch : sketches) {
+            result.push_back(sketch.quantile(q));
+        }
+        return result;
     }
 
     std::vector<double> means(DataFrame& df) {
@@ -36,17 +369,10 @@ namespace descriptiveStatistics {
             throw std::invalid_argument("Cannot calculate means on empty DataFrame.");
         }
 
-        std::vector<std::string> colnames = df.getColNames();
         std::vector<double> meansVec;
-        int n = df.getDim().first;
-
-        for (const auto& colname : colnames) {
-            double sum = 0;
-            auto column = df.getColumn(colname).getDataAsDouble();
-            for (int i = 0; i < n; ++i) sum += column[i];
-            meansVec.push_back(sum / n);
+        for (const ColumnSummary& summary : describe(df)) {
+            meansVec.push_back(summary.mean);
         }
-
         return meansVec;
     }
 
@@ -55,56 +381,187 @@ namespace descriptiveStatistics {
             throw std::invalid_argument("Cannot calculate variances on empty DataFrame.");
         }
 
-        std::vector<double> meansVec = means(df);
         std::vector<double> vars;
-        int n = df.getDim().first;
-        auto colnames = df.getColNames();
-
-        for (size_t i = 0; i < colnames.size(); ++i) {
-            double sum = 0;
-            auto column = df.getColumn(colnames[i]).getDataAsDouble();
-            for (int j = 0; j < n; ++j) {
-                sum += std::pow(column[j] - meansVec[i], 2);
-            }
-            vars.push_back(sum / (n - 1));
+        for (const ColumnSummary& summary : describe(df)) {
+            vars.push_back(summary.variance());
         }
-
         return vars;
     }
 
     std::vector<double> standardDeviations(DataFrame& df) {
-        std::vector<double> vars = variances(df);
+        if (df.getDim().first == 0 || df.getDim().second == 0) {
+            throw std::invalid_argument("Cannot calculate standard deviations on empty DataFrame.");
+        }
+
         std::vector<double> stddevs;
-        for (double v : vars) {
-            stddevs.push_back(std::sqrt(v));
+        for (const ColumnSummary& summary : describe(df)) {
+            stddevs.push_back(summary.standardDeviation());
         }
         return stddevs;
     }
 
-    DataFrame covariances(DataFrame& df) {
+    DataFrame covariances(const DataFrame& df) {
         if (df.getDim().first == 0 || df.getDim().second < 1) {
             throw std::invalid_argument("Cannot calculate covariance for an empty or single-variable DataFrame.");
         }
 
-        Eigen::MatrixXd covMat = covariancesEigen(df);
-        DataFrame result;
-        auto colnames = df.getColNames();
+        return matrixToDataFrame(covariancesEigen(df), df.getColNames());
+    }
 
-        for (size_t i = 0; i < colnames.size(); ++i) {
-            std::vector<double> colVec(covMat.col(i).data(), covMat.col(i).data() + covMat.col(i).size());
-            result.addColumn(colVec, colnames[i]);
+    Eigen::MatrixXd correlationsEigen(const DataFrame& df, bool pairwiseComplete) {
+        if (df.getDim().first == 0 || df.getDim().second < 1) {
+            throw std::invalid_argument("Cannot calculate Correlation of fewer than 2 variables.");
         }
+        if (pairwiseComplete) return pairwiseCorrelations(df);
 
-        result.setRowNames(colnames);
-        return result;
+        // Scaling the covariance matrix by the standard deviations on its diagonal
+        Eigen::MatrixXd correlationMat = covariancesEigen(df);
+        Eigen::VectorXd invStdevs = correlationMat.diagonal().cwiseSqrt().cwiseInverse();
+        correlationMat = invStdevs.asDiagonal() * correlationMat * invStdevs.asDiagonal();
+        for (int i = 0; i < correlationMat.rows(); ++i) {
+            if (std::isfinite(invStdevs(i))) correlationMat(i, i) = 1.0;
+        }
+        return correlationMat;
+    }
+
+    DataFrame correlations(const DataFrame& df, bool pairwiseComplete) {
+        return matrixToDataFrame(correlationsEigen(df, pairwiseComplete), df.getColNames());
+    }
+
+    void CovarianceAccumulator::checkColNames(const std::vector<std::string>& otherColNames) const {
+        if (otherColNames != colNames) {
+            throw std::invalid_argument("Covariance accumulator: the columns differ from the columns accumulated before");
+        }
+    }
+
+    void CovarianceAccumulator::add(const DataFrame& batch) {
+        if (batch.getDim().first == 0) return;
+
+        CovarianceAccumulator batchAccumulator;
+        batchAccumulator.count = batch.getDim().first;
+        batchAccumulator.colNames = batch.getColNames();
+        batchAccumulator.meansVec = columnMeans(batch);
+        batchAccumulator.coMoments = Eigen::MatrixXd::Zero(batch.getDim().second, batch.getDim().second);
+        addCoMoments(batch, batchAccumulator.meansVec, batchAccumulator.coMoments);
+        merge(batchAccumulator);
+    }
+
+    void CovarianceAccumulator::merge(const CovarianceAccumulator& other) {
+        if (other.count == 0) return;
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        checkColNames(other.colNames);
+
+        // Only the lower triangle of the co-moments is kept up to date
+        const long long n = count + other.count;
+        Eigen::VectorXd delta = other.meansVec - meansVec;
+        meansVec += delta * (static_cast<double>(other.count) / n);
+        coMoments += other.coMoments;
+        coMoments.selfadjointView<Eigen::Lower>().rankUpdate(delta, static_cast<double>(count) * other.count / n);
+        count = n;
+    }
+
+    long long CovarianceAccumulator::getCount() const {
+        return count;
+    }
+
+    std::vector<std::string> CovarianceAccumulator::getColNames() const {
+        return colNames;
+    }
+
+    std::vector<double> CovarianceAccumulator::getMeans() const {
+        return std::vector<double>(meansVec.data(), meansVec.data() + meansVec.size());
+    }
+
+    Eigen::MatrixXd CovarianceAccumulator::covariancesEigen() const {
+        if (count < 2) {
+            throw std::invalid_argument("Cannot calculate Covariance of fewer than 2 rows.");
+        }
+        Eigen::MatrixXd covarianceMat = coMoments.selfadjointView<Eigen::Lower>();
+        return covarianceMat / static_cast<double>(count - 1);
+    }
+
+    DataFrame CovarianceAccumulator::covariances() const {
+        return matrixToDataFrame(covariancesEigen(), colNames);
+    }
+
+    std::string CovarianceAccumulator::serialize() const {
+        // Layout: magic, version, byte order mark, nr. rows, nr. cols, per column (name length, name), means, lower triangle by column
+        const std::uint32_t p = static_cast<std::uint32_t>(colNames.size());
+        std::string blob(accumulatorMagic, sizeof(accumulatorMagic));
+        append<std::uint32_t>(blob, accumulatorVersion);
+        append<std::uint32_t>(blob, byteOrderMark);
+        append<std::int64_t>(blob, count);
+        append<std::uint32_t>(blob, p);
+        for (const std::string& name : colNames) {
+            append<std::uint32_t>(blob, static_cast<std::uint32_t>(name.size()));
+            blob += name;
+        }
+        for (std::uint32_t i = 0; i < p; ++i) append<double>(blob, meansVec(i));
+        for (std::uint32_t j = 0; j < p; ++j) {
+            for (std::uint32_t i = j; i < p; ++i) append<double>(blob, coMoments(i, j));
+        }
+        return blob;
+    }
+
+    CovarianceAccumulator CovarianceAccumulator::deserialize(std::string_view blob) {
+        if (blob.size() < sizeof(accumulatorMagic) || std::memcmp(blob.data(), accumulatorMagic, sizeof(accumulatorMagic)) != 0) {
+            throw std::runtime_error("Not a covariance accumulator blob");
+        }
+        std::size_t pos = sizeof(accumulatorMagic);
+        if (read<std::uint32_t>(blob, pos) != accumulatorVersion) {
+            throw std::runtime_error("Unsupported covariance accumulator version");
+        }
+        if (read<std::uint32_t>(blob, pos) != byteOrderMark) {
+            throw std::runtime_error("Covariance accumulator blob was written with another byte order");
+        }
+
+        CovarianceAccumulator accumulator;
+        accumulator.count = read<std::int64_t>(blob, pos);
+        const std::uint32_t p = read<std::uint32_t>(blob, pos);
+        if (accumulator.count < 0 || p > blob.size()) throw std::runtime_error("Covariance accumulator blob is invalid");
+        for (std::uint32_t i = 0; i < p; ++i) {
+            std::uint32_t length = read<std::uint32_t>(blob, pos);
+            if (length > blob.size() - pos) throw std::runtime_error("Covariance accumulator blob is truncated");
+            accumulator.colNames.emplace_back(blob.substr(pos, length));
+            pos += length;
+        }
+        accumulator.meansVec.resize(p);
+        for (std::uint32_t i = 0; i < p; ++i) accumulator.meansVec(i) = read<double>(blob, pos);
+        accumulator.coMoments = Eigen::MatrixXd::Zero(p, p);
+        for (std::uint32_t j = 0; j < p; ++j) {
+            for (std::uint32_t i = j; i < p; ++i) accumulator.coMoments(i, j) = read<double>(blob, pos);
+        }
+        if (pos != blob.size()) throw std::runtime_error("Covariance accumulator blob is invalid");
+        return accumulator;
+    }
+
+    bool isConstant(const Column& col) {
+        // Every chunk compares its values to the first value, chunks are skipped, once a difference was found
+        std::vector<ColumnChunk> chunks = splitColumns({&col});
+        std::atomic<bool> constant{true};
+        ThreadPool::global().parallelFor(static_cast<int>(chunks.size()), [&](int i) {
+            if (!constant.load(std::memory_order_relaxed)) return;
+            bool chunkConstant = col.visit([&chunk = chunks[i]](auto data) {
+                for (std::size_t k = chunk.begin; k < chunk.end; ++k) {
+                    if (data[k] != data[0]) return(false);
+                }
+                return(true);
+            });
+            if (!chunkConstant) constant.store(false, std::memory_order_relaxed);
+        });
+        return constant.load();
     }
 
-    bool isConstant(Column& col) {
-        std::vector<double> column = col.getDataAsDouble();
-        for(unsigned int i = 1; i < col.size(); i++) {
-            if(column[i-1] != column[i]) return(false);
+    std::vector<bool> constantColumns(const DataFrame& df) {
+        std::vector<bool> constant;
+        for (const ColumnSummary& summary : describe(df)) {
+            // A NaN value makes the mean NaN, the column is not constant then (like in isConstant)
+            constant.push_back(summary.count == 0 || (summary.min == summary.max && !std::isnan(summary.mean)));
         }
-        return(true);
+        return constant;
     }
 
 }  // namespace descriptiveStatistics
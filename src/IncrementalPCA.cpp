@@ -0,0 +1,110 @@
+#include "IncrementalPCA.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+
+IncrementalPCA::IncrementalPCA(int nComponents) : nComponents(nComponents) {
+    if(nComponents < 1) throw std::invalid_argument("IncrementalPCA needs at least one component");
+}
+
+void IncrementalPCA::partialFit(DataFrame& df) {
+    if(df.empty()) throw std::invalid_argument("Cannot fit IncrementalPCA on empty DataFrame.");
+    if(count > 0 && colsOfFit != df.getDim().second) {
+        throw std::invalid_argument("Input data needs to have the same number of columns, then the data, which was used in the previous batches!");
+    }
+
+    const int m = df.getDim().first;
+    const int p = df.getDim().second;
+    Eigen::MatrixXd batch = castingHelper::dataFrameToEigenMatrix(df);
+    Eigen::RowVectorXd batchMean = batch.colwise().mean();
+    batch.rowwise() -= batchMean;
+
+    const long long total = count + m;
+    const int stateRows = static_cast<int>(singularValues.size());
+
+    // Stack the current state (S * V^T), the centered batch and the correction of the difference of both means
+    Eigen::MatrixXd stacked(stateRows + m + (count > 0 ? 1 : 0), p);
+    if(stateRows > 0) stacked.topRows(stateRows) = singularValues.asDiagonal() * components;
+    stacked.middleRows(stateRows, m) = batch;
+    if(count > 0) {
+        stacked.bottomRows(1) = std::sqrt(static_cast<double>(count) * m / total) * (mean - batchMean);
+        mean += (batchMean - mean) * (static_cast<double>(m) / total);
+    } else {
+        mean = batchMean;
+    }
+
+    Eigen::BDCSVD<Eigen::MatrixXd> svd(stacked, Eigen::ComputeThinV);
+    const int kept = std::min<int>(nComponents, svd.singularValues().size());
+    singularValues = svd.singularValues().head(kept);
+    components = svd.matrixV().leftCols(kept).transpose();
+
+    count = total;
+    colsOfFit = p;
+}
+
+DataFrame IncrementalPCA::transform(DataFrame& df, int dim) {
+    if(count == 0) throw std::runtime_error("IncrementalPCA has to be fitted first, before transforming data!");
+    if(colsOfFit != df.getDim().second) {
+        throw std::runtime_error("Input data needs to have the same number of columns, then the data, which was used in fit!");
+    }
+    if(dim <= 0) throw std::invalid_argument("Dim has to be greater than 0");
+
+    if(components.rows() < dim) {
+        dim = components.rows();
+        std::cerr << "Warning: Only " + std::to_string(dim) + " Principal Components available" << std::endl;
+    }
+
+    std::vector<std::string> colNames(dim);
+    for (int i = 0; i < dim; ++i) {
+        colNames[i] = "PrincipalComponent" + std::to_string(i);
+    }
+
+    // The centering is folded into an offset, so the raw data is projected with a single GEMM
+    Eigen::MatrixXd projection = components.topRows(dim).transpose();
+    Eigen::RowVectorXd offset = -mean * projection;
+    Eigen::MatrixXd data = castingHelper::dataFrameToEigenMatrix(df);
+    Eigen::MatrixXd reducedData(data.rows(), dim);
+    reducedData.noalias() = data * projection;
+    reducedData.rowwise() += offset;
+
+    return(castingHelper::eigenMatrixToDataFrame(reducedData, colNames));
+}
+
+long long IncrementalPCA::getCount() const {
+    return count;
+}
+
+std::vector<double> IncrementalPCA::getMeans() const {
+    return std::vector<double>(mean.data(), mean.data() + mean.size());
+}
+
+std::vector<double> IncrementalPCA::getEigenvalues() const {
+    std::vector<double> eigenvalues;
+    for(int i = 0; i < singularValues.size(); i++) {
+        eigenvalues.push_back(count > 1 ? singularValues(i) * singularValues(i) / (count - 1) : 0.0);
+    }
+    return(eigenvalues);
+}
+
+std::vector<std::vector<double>> IncrementalPCA::getEigenvectors() const {
+    std::vector<std::vector<double>> eigenvectors;
+    for(int i = 0; i < components.rows(); i++) {
+        Eigen::VectorXd eigenVec = components.row(i).transpose();
+        eigenvectors.emplace_back(eigenVec.data(), eigenVec.data() + eigenVec.size());
+    }
+    return(eigenvectors);
+}
+
+DataFrame IncrementalPCA::getEigenInformation() const {
+    std::vector<double> eigenvalues = getEigenvalues();
+    std::vector<std::vector<double>> eigenVecs = getEigenvectors();
+    DataFrame eigenInformation;
+    for(unsigned int i = 0; i < eigenvalues.size(); i++) {
+        std::string colname = "EV=" + std::to_string(eigenvalues[i]);
+        eigenInformation.addColumn(eigenVecs[i], colname);
+    }
+
+    return(eigenInformation);
+}
@@ -1,12 +1,24 @@
 #include "LinAlgOps.hpp"
 
-namespace linAlgOps {
+#include <algorithm>
+#include <random>
+#include <stdexcept>
 
-    std::pair<Eigen::VectorXd, Eigen::MatrixXd> singularValueDecomposition(Eigen::MatrixXd& X) {
-        Eigen::JacobiSVD<Eigen::MatrixXd> svd(X, Eigen::ComputeThinU | Eigen::ComputeThinV);
+namespace linAlgOps {
 
-        Eigen::VectorXd eigenvalues = svd.singularValues();
-        Eigen::MatrixXd eigenvectors = svd.matrixV();
+    std::pair<Eigen::VectorXd, Eigen::MatrixXd> singularValueDecomposition(Eigen::MatrixXd& X, bool divideAndConquer) {
+        Eigen::VectorXd eigenvalues;
+        Eigen::MatrixXd eigenvectors;
+        // Only V is needed, U would be as large as X
+        if (divideAndConquer) {
+            Eigen::BDCSVD<Eigen::MatrixXd> svd(X, Eigen::ComputeThinV);
+            eigenvalues = svd.singularValues();
+            eigenvectors = svd.matrixV();
+        } else {
+            Eigen::JacobiSVD<Eigen::MatrixXd> svd(X, Eigen::ComputeThinV);
+            eigenvalues = svd.singularValues();
+            eigenvectors = svd.matrixV();
+        }
 
         int n = X.rows();
         for (int i = 0; i < eigenvalues.size(); ++i) {
@@ -31,4 +43,134 @@ namespace linAlgOps {
         return(std::make_pair(eigenvalues, eigenvectors));
     }
 
+    std::pair<Eigen::VectorXd, Eigen::MatrixXd> lanczosEigen(const Eigen::MatrixXd& X, int k, double tol) {
+        const int p = X.rows();
+        if (X.cols() != p) throw std::invalid_argument("Lanczos method needs a square (symmetric) matrix");
+        if (k <= 0 || k > p) throw std::invalid_argument("Number of eigenpairs has to be between 1 and the size of the matrix");
+
+        std::mt19937 random(42);
+        std::normal_distribution<double> normal;
+        // Random unit vector, orthogonal to the first columns of the basis
+        auto randomVector = [&](const Eigen::MatrixXd& basis, int columns) {
+            Eigen::VectorXd v(p);
+            for (int i = 0; i < p; ++i) v(i) = normal(random);
+            for (int pass = 0; pass < 2; ++pass) v -= basis.leftCols(columns) * (basis.leftCols(columns).transpose() * v);
+            return Eigen::VectorXd(v.normalized());
+        };
+
+        // The basis grows by doubling, the convergence is checked every checkInterval steps
+        const int checkInterval = 8;
+        Eigen::MatrixXd basis(p, std::min(p, 2 * k + 2 * checkInterval));
+        std::vector<double> alpha, beta;
+        Eigen::VectorXd v = randomVector(basis, 0);
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> tridiagonal;
+        const double breakdown = 1e-12 * std::max(1.0, X.cwiseAbs().maxCoeff());
+
+        int m = 0;
+        while (true) {
+            if (m == basis.cols()) basis.conservativeResize(Eigen::NoChange, std::min(p, 2 * m));
+            basis.col(m) = v;
+            Eigen::VectorXd w = X * v;
+            alpha.push_back(v.dot(w));
+            // Full reorthogonalization (twice) against the whole basis keeps the basis orthonormal in floating point
+            for (int pass = 0; pass < 2; ++pass) w -= basis.leftCols(m + 1) * (basis.leftCols(m + 1).transpose() * w);
+            double norm = w.norm();
+            ++m;
+
+            const bool invariant = norm < breakdown;
+            if (m >= k && (m == p || invariant || m % checkInterval == 0)) {
+                Eigen::VectorXd diagonal = Eigen::Map<Eigen::VectorXd>(alpha.data(), m);
+                Eigen::VectorXd subDiagonal = Eigen::Map<Eigen::VectorXd>(beta.data(), m - 1);
+                tridiagonal.computeFromTridiagonal(diagonal, subDiagonal, Eigen::ComputeEigenvectors);
+                // The residual of a Ritz pair is the norm of the next Lanczos vector times the last entry of its eigenvector
+                const double scale = std::max(tridiagonal.eigenvalues().cwiseAbs().maxCoeff(), breakdown);
+                bool converged = m == p;
+                if (!converged) {
+                    converged = true;
+                    for (int i = m - k; i < m; ++i) {
+                        if (norm * std::abs(tridiagonal.eigenvectors()(m - 1, i)) > tol * scale) converged = false;
+                    }
+                }
+                if (converged) break;
+            }
+
+            // An invariant subspace was found, the Krylov sequence is restarted with a new vector orthogonal to it
+            if (invariant) {
+                v = randomVector(basis, m);
+                beta.push_back(0.0);
+            } else {
+                v = w / norm;
+                beta.push_back(norm);
+            }
+        }
+
+        // The eigenvalues of the tridiagonal matrix are sorted increasingly, the top k are the last ones
+        Eigen::VectorXd eigenvalues = tridiagonal.eigenvalues().tail(k);
+        Eigen::MatrixXd eigenvectors = basis.leftCols(m) * tridiagonal.eigenvectors().rightCols(k);
+
+        return(std::make_pair(eigenvalues, eigenvectors));
+    }
+
+    std::pair<Eigen::VectorXd, Eigen::MatrixXd> randomizedSvd(const Eigen::MatrixXd& X, int k, const Eigen::VectorXd& center,
+                                                              const Eigen::VectorXd& scale, int oversampling, int powerIterations) {
+        const int n = X.rows();
+        const int p = X.cols();
+        if (k <= 0 || k > std::min(n, p)) {
+            throw std::invalid_argument("Number of components has to be between 1 and the minimum of the number of rows and columns");
+        }
+        if (oversampling < 0 || powerIterations < 0) {
+            throw std::invalid_argument("Oversampling and power iterations must not be negative");
+        }
+        if ((center.size() != 0 && center.size() != p) || (scale.size() != 0 && scale.size() != p)) {
+            throw std::invalid_argument("Center and scale need one value per column");
+        }
+
+        const int samples = std::min(k + oversampling, std::min(n, p));
+        const Eigen::VectorXd c = center.size() != 0 ? center : Eigen::VectorXd::Zero(p);
+        const Eigen::VectorXd d = scale.size() != 0 ? scale : Eigen::VectorXd::Ones(p);
+
+        // A * M = X * (D * M) - 1 * (c^T * D * M)
+        auto multiply = [&](const Eigen::MatrixXd& M) {
+            Eigen::MatrixXd scaled = d.asDiagonal() * M;
+            Eigen::MatrixXd result = X * scaled;
+            result.rowwise() -= c.transpose() * scaled;
+            return result;
+        };
+        // A^T * M = D * (X^T * M - c * (1^T * M))
+        auto multiplyTransposed = [&](const Eigen::MatrixXd& M) {
+            Eigen::MatrixXd result = X.transpose() * M;
+            result.noalias() -= c * M.colwise().sum();
+            return Eigen::MatrixXd(d.asDiagonal() * result);
+        };
+        // Every product is orthonormalized, so that the power iterations do not lose the smaller components to rounding
+        auto orthonormalize = [](const Eigen::MatrixXd& M) {
+            Eigen::HouseholderQR<Eigen::MatrixXd> qr(M);
+            return Eigen::MatrixXd(qr.householderQ() * Eigen::MatrixXd::Identity(M.rows(), M.cols()));
+        };
+
+        std::mt19937 random(42);
+        std::normal_distribution<double> normal;
+        Eigen::MatrixXd omega(p, samples);
+        for (int j = 0; j < samples; ++j) {
+            for (int i = 0; i < p; ++i) omega(i, j) = normal(random);
+        }
+
+        Eigen::MatrixXd Q = orthonormalize(multiply(omega));
+        for (int iteration = 0; iteration < powerIterations; ++iteration) {
+            Q = orthonormalize(multiply(orthonormalize(multiplyTransposed(Q))));
+        }
+
+        // B = Q^T * A is small (samples x p). With B^T = U * S * W^T, the right singular vectors of B (and A) are the columns of U
+        Eigen::MatrixXd Bt = multiplyTransposed(Q);
+        Eigen::JacobiSVD<Eigen::MatrixXd> svd(Bt, Eigen::ComputeThinU);
+
+        Eigen::VectorXd eigenvalues = svd.singularValues().head(k);
+        for (int i = 0; i < k; ++i) {
+            eigenvalues(i) = (eigenvalues(i) * eigenvalues(i)) / (n - 1);
+        }
+        Eigen::MatrixXd eigenvectors = svd.matrixU().leftCols(k);
+
+        return(std::make_pair(eigenvalues, eigenvectors));
+    }
+
 }  // namespace linAlgOps
@@ -0,0 +1,39 @@
+#include "MappedFile.hpp"
+
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+
+    struct stat fileInfo;
+    if (::fstat(fd, &fileInfo) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Could not read the size of file: " + filename);
+    }
+    mappedSize = static_cast<std::size_t>(fileInfo.st_size);
+
+    // mmap does not allow mappings of length 0, an empty file simply has no data
+    if (mappedSize > 0) {
+        void* mapping = ::mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Could not map file: " + filename);
+        }
+        mappedData = static_cast<const char*>(mapping);
+    }
+    // The mapping stays valid after closing the file descriptor
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (mappedData != nullptr) {
+        ::munmap(const_cast<char*>(mappedData), mappedSize);
+    }
+}
@@ -1,21 +1,20 @@
 
 #include "PCA.hpp"
 
+namespace {
+    // Thresholds of chooseSolver, from Examples/PcaSolverBenchmark.cpp (see there for the measurements)
+    // The truncated solvers (Lanczos, randomized SVD) are used, if at most 1 / fewComponentsRatio of the components are requested
+    constexpr int fewComponentsRatio = 10;
+    // Minimum number of variables, from which on the randomized SVD beats Lanczos on the covariance matrix (crossover between 500 and 1000)
+    constexpr int minColsRandomized = 800;
+    // The divide-and-conquer SVD of the data beats the covariance eigendecomposition up to maxRowsPerColBDC rows per variable
+    constexpr int maxRowsPerColBDC = 2;
+}
 
-PCA::PCA() = default;
 
-void PCA::fitHelper(Eigen::MatrixXd X, bool svd) {
-    
-    std::pair<Eigen::VectorXd, Eigen::MatrixXd> eigenDecomp;
-    if(svd) {
-        eigenDecomp = linAlgOps::singularValueDecomposition(X);
-    } else {
-        eigenDecomp = linAlgOps::spectralDecomposition(X);
-    }
-
-    Eigen::VectorXd eigenvalues = eigenDecomp.first;
-    Eigen::MatrixXd eigenvectors = eigenDecomp.second;
+PCA::PCA() = default;
 
+void PCA::setEigenPairs(const Eigen::VectorXd& eigenvalues, const Eigen::MatrixXd& eigenvectors) {
     // If an old fit already happened, clear it before adding the newly calculated info
     if (!eigenPairs.empty()) {
         eigenPairs.clear();
@@ -28,6 +27,43 @@ void PCA::fitHelper(Eigen::MatrixXd X, bool svd) {
                 [](const auto& a, const auto& b) { return a.first < b.first; });
 }
 
+void PCA::updateProjection() {
+    int p = colsOfFit;
+    projection.resize(p, eigenPairs.size());
+    for (unsigned int i = 0; i < eigenPairs.size(); ++i) {
+        projection.col(i) = eigenPairs[i].second;
+    }
+    offset = Eigen::RowVectorXd::Zero(eigenPairs.size());
+
+    if(centerAndScale) {
+        auto [meansVec, invStdevs] = normalization();
+        projection = invStdevs.asDiagonal() * projection;
+        offset.noalias() = -meansVec.transpose() * projection;
+    }
+}
+
+std::pair<Eigen::VectorXd, Eigen::VectorXd> PCA::normalization() {
+    std::vector<double> means = stdscaler.getMeans();
+    Eigen::VectorXd meansVec = Eigen::Map<Eigen::VectorXd>(means.data(), means.size());
+    Eigen::VectorXd invStdevs;
+    if(centerAndScale) {
+        std::vector<double> stdevs = stdscaler.getStdevs();
+        invStdevs = Eigen::Map<Eigen::VectorXd>(stdevs.data(), stdevs.size()).cwiseInverse();
+    }
+    return(std::make_pair(meansVec, invStdevs));
+}
+
+PcaSolver PCA::chooseSolver(int n, int p, int nComponents, bool isCovariance) {
+    const bool fewComponents = nComponents > 0 && nComponents * fewComponentsRatio <= p;
+    // A given covariance matrix can only be decomposed by the eigensolvers
+    if(isCovariance) return(fewComponents ? PcaSolver::Lanczos : PcaSolver::CovarianceEigen);
+    // For many variables, forming the covariance matrix costs more than the products of the randomized SVD
+    if(fewComponents) return(p >= minColsRandomized ? PcaSolver::Randomized : PcaSolver::Lanczos);
+    // For wide data, the SVD of the data is cheaper than the eigendecomposition of the large covariance matrix
+    if(static_cast<long long>(n) <= static_cast<long long>(maxRowsPerColBDC) * p) return(PcaSolver::BDC);
+    return(PcaSolver::CovarianceEigen);
+}
+
 DataFrame PCA::transformHelper(DataFrame& df, int dim) {
     Eigen::MatrixXd data = castingHelper::dataFrameToEigenMatrix(df);
 
@@ -38,25 +74,25 @@ DataFrame PCA::transformHelper(DataFrame& df, int dim) {
         std::cerr << "Warning: Only " + std::to_string(dim) + " Principal Components available" << std::endl;
     }
 
-    Eigen::MatrixXd projectionMatrix(df.getDim().second, dim);
     std::vector<std::string> colNames(dim);
     for (int i = 0; i < dim; ++i) {
         colNames[i] = "PrincipalComponent" + std::to_string(i);
-        projectionMatrix.col(i) = eigenPairs[i].second;
     }
 
-    Eigen::MatrixXd reducedData = data * projectionMatrix;
+    Eigen::MatrixXd reducedData(data.rows(), dim);
+    reducedData.noalias() = data * projection.leftCols(dim);
+    if(centerAndScale) reducedData.rowwise() += offset.head(dim);
 
     return(castingHelper::eigenMatrixToDataFrame(reducedData, colNames));
 }
 
 
 void PCA::constantColWarning(DataFrame& df, bool isCovariance) {
-    std::vector<std::string> colNames = df.getColNames();
+    // Served from the memoized column summaries, which are reused by the StandardScaler afterwards
+    std::vector<bool> constantCols = descriptiveStatistics::constantColumns(df);
 
-    for(unsigned int i = 0; i < colNames.size(); i++) {
-        Column col = df.getColumn(colNames[i]);
-        bool constant = descriptiveStatistics::isConstant(col);
+    for(unsigned int i = 0; i < constantCols.size(); i++) {
+        bool constant = constantCols[i];
         if(constant && this->centerAndScale && !isCovariance) {
             throw std::invalid_argument("DataFrame has constant columns and can thus not be centered and scaled, because of 0 variance of constant Columns. Please remove constant columns");
             break;
@@ -68,35 +104,87 @@ void PCA::constantColWarning(DataFrame& df, bool isCovariance) {
 }
 
 
-void PCA::fit(DataFrame& df, bool centerAndScale, bool svd, bool isCovariance) {
+void PCA::fit(DataFrame& df, bool centerAndScale, PcaSolver solver, bool isCovariance, int nComponents) {
 
     if(df.getDim().first == 0 || df.getDim().second < 2) throw std::invalid_argument("DataFrame has to have at least two variables for the PCA to be calculated");
 
-    this->centerAndScale = centerAndScale;
-    this->colsOfFit = df.getDim().second;
+    const int n = df.getDim().first;
+    const int p = df.getDim().second;
+    if(nComponents < 0 || nComponents > p) throw std::invalid_argument("Number of components has to be between 0 (all components) and the number of variables");
+
+    // A given covariance matrix is not normalized
+    this->centerAndScale = centerAndScale && !isCovariance;
+    this->colsOfFit = p;
 
     constantColWarning(df, isCovariance);
 
-    DataFrame dfScaled;
-    if(centerAndScale) {
-        stdscaler = StandardScaler();
-        dfScaled = stdscaler.fitTransform(df);
-    }
+    if(solver == PcaSolver::Auto) solver = chooseSolver(n, p, nComponents, isCovariance);
+    const int k = nComponents == 0 ? p : nComponents;
 
-    // If the matrix is already the covariance matrix, don't use the SVD
-    if(svd && !isCovariance) {
-        if(centerAndScale) fitHelper(castingHelper::dataFrameToEigenMatrix(dfScaled), true);
-        else fitHelper(castingHelper::dataFrameToEigenMatrix(df), true);
+    std::pair<Eigen::VectorXd, Eigen::MatrixXd> eigenDecomp;
+    if(isCovariance) {
+        // Without the data, the SVD solvers fall back to the eigendecomposition
+        Eigen::MatrixXd covMat = castingHelper::getSymEigenMatrix(df);
+        if(solver == PcaSolver::Lanczos) eigenDecomp = linAlgOps::lanczosEigen(covMat, k);
+        else eigenDecomp = linAlgOps::spectralDecomposition(covMat);
     } else {
-        Eigen::MatrixXd covMat;
-        if(isCovariance) {
-            covMat = castingHelper::getSymEigenMatrix(df);
-        } else {
-            if(centerAndScale) covMat = descriptiveStatistics::covariancesEigen(dfScaled);
-            else covMat = descriptiveStatistics::covariancesEigen(df);
+        // Only the means and standard deviations are needed, the normalized data is never materialized as DataFrame
+        stdscaler = StandardScaler();
+        stdscaler.fit(df);
+
+        switch(solver) {
+            case PcaSolver::Jacobi:
+            case PcaSolver::BDC: {
+                // The SVD of the centered (and scaled) data
+                Eigen::MatrixXd X = castingHelper::dataFrameToEigenMatrix(df);
+                auto [meansVec, invStdevs] = normalization();
+                X.rowwise() -= meansVec.transpose();
+                if(this->centerAndScale) X = X * invStdevs.asDiagonal();
+                eigenDecomp = linAlgOps::singularValueDecomposition(X, solver == PcaSolver::BDC);
+                break;
+            }
+            case PcaSolver::Randomized: {
+                Eigen::MatrixXd X = castingHelper::dataFrameToEigenMatrix(df);
+                auto [meansVec, invStdevs] = normalization();
+                eigenDecomp = linAlgOps::randomizedSvd(X, std::min(k, n), meansVec, invStdevs);
+                break;
+            }
+            default: {
+                // The covariance matrix of the normalized data is the correlation matrix of the raw data
+                Eigen::MatrixXd covMat;
+                if(this->centerAndScale) covMat = descriptiveStatistics::correlationsEigen(df);
+                else covMat = descriptiveStatistics::covariancesEigen(df);
+                if(solver == PcaSolver::Lanczos) eigenDecomp = linAlgOps::lanczosEigen(covMat, k);
+                else eigenDecomp = linAlgOps::spectralDecomposition(covMat);
+                break;
+            }
         }
-        fitHelper(covMat, false);
     }
+
+    setEigenPairs(eigenDecomp.first, eigenDecomp.second);
+    if(nComponents > 0 && eigenPairs.size() > static_cast<size_t>(nComponents)) eigenPairs.resize(nComponents);
+    updateProjection();
+    hasFitted = true;
+}
+
+void PCA::fitRandomized(DataFrame& df, int k, bool centerAndScale, int oversampling, int powerIterations) {
+
+    if(df.getDim().first == 0 || df.getDim().second < 2) throw std::invalid_argument("DataFrame has to have at least two variables for the PCA to be calculated");
+
+    this->centerAndScale = centerAndScale;
+    this->colsOfFit = df.getDim().second;
+
+    constantColWarning(df, false);
+
+    // The means are needed for the centering in any case, the standard deviations only for the scaling
+    stdscaler = StandardScaler();
+    stdscaler.fit(df);
+    auto [center, scale] = normalization();
+
+    Eigen::MatrixXd X = castingHelper::dataFrameToEigenMatrix(df);
+    std::pair<Eigen::VectorXd, Eigen::MatrixXd> eigenDecomp = linAlgOps::randomizedSvd(X, k, center, scale, oversampling, powerIterations);
+    setEigenPairs(eigenDecomp.first, eigenDecomp.second);
+    updateProjection();
     hasFitted = true;
 }
 
@@ -108,21 +196,13 @@ DataFrame PCA::transform(DataFrame& df, int dim) {
         throw std::runtime_error("Input data needs to have the same number of columns, then the data, which was used in fit!");
     }
     
-    if(this->centerAndScale) {
-        constantColWarning(df, false);
-        // This case is for security, but should never happen, since if centerAndScale == true, the scaler has be fitted
-        if(stdscaler.getMeans().empty()) throw std::runtime_error("StandardScaler was not fitted!");
-        // Note: The input for transform is scaled with the standardscaler fitted on the training data
-        DataFrame dfNew = stdscaler.transform(df);
-        return(transformHelper(dfNew, dim));
-    } else {
-        // The use of the transformHelper here, is that if no scaling is needed, no copy of the dataframe has to be made
-        return(transformHelper(df, dim));
-    }
+    // Note: If centerAndScale is true, the input is normalized with the means and standard deviations of the training data,
+    // which are part of the projection
+    return(transformHelper(df, dim));
 }
 
-DataFrame PCA::fitTransform(DataFrame& df, bool centerAndScale, bool svd, bool isCovariance, int dim) {
-    fit(df, centerAndScale, svd, isCovariance);
+DataFrame PCA::fitTransform(DataFrame& df, bool centerAndScale, PcaSolver solver, bool isCovariance, int dim) {
+    fit(df, centerAndScale, solver, isCovariance);
     return(transform(df, dim));
 }
 
@@ -0,0 +1,142 @@
+#include "QuantileSketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace descriptiveStatistics {
+
+    QuantileSketch::QuantileSketch(int k, std::size_t exactLimit) : k(k), exactLimit(exactLimit) {
+        if (k < 8) {
+            throw std::invalid_argument("The accuracy parameter k of a quantile sketch has to be at least 8");
+        }
+        addLevel();
+    }
+
+    std::size_t QuantileSketch::capacity(std::size_t level) const {
+        // The capacity shrinks by 2/3 per level below the top level
+        const std::size_t depth = levels.size() - 1 - level;
+        return std::max<std::size_t>(2, static_cast<std::size_t>(std::ceil(k * std::pow(2.0 / 3.0, depth))));
+    }
+
+    void QuantileSketch::addLevel() {
+        levels.emplace_back();
+        maxSize = 0;
+        for (std::size_t level = 0; level < levels.size(); ++level) maxSize += capacity(level);
+    }
+
+    void QuantileSketch::compress() {
+        // Small inputs are kept exactly, until the first compaction
+        if (isExact() && size <= exactLimit) return;
+
+        while (size >= maxSize) {
+            for (std::size_t level = 0; level < levels.size(); ++level) {
+                if (levels[level].size() < capacity(level)) continue;
+                if (level + 1 == levels.size()) addLevel();
+
+                // Every second value of the sorted level moves up with twice the weight, a value left over by an odd size stays
+                std::vector<double>& values = levels[level];
+                std::sort(values.begin(), values.end());
+                double leftOver = 0;
+                const bool odd = values.size() % 2 == 1;
+                if (odd) {
+                    leftOver = values.back();
+                    values.pop_back();
+                }
+                const std::size_t offset = random() % 2;
+                std::vector<double>& next = levels[level + 1];
+                for (std::size_t i = offset; i < values.size(); i += 2) next.push_back(values[i]);
+                size -= values.size() / 2;
+                values.clear();
+                if (odd) values.push_back(leftOver);
+                break;
+            }
+        }
+    }
+
+    void QuantileSketch::add(double val) {
+        if (std::isnan(val)) return;
+        ++count;
+        minValue = std::min(minValue, val);
+        maxValue = std::max(maxValue, val);
+        levels[0].push_back(val);
+        ++size;
+        if (size >= maxSize) compress();
+    }
+
+    void QuantileSketch::merge(const QuantileSketch& other) {
+        if (other.count == 0) return;
+        while (levels.size() < other.levels.size()) addLevel();
+        for (std::size_t level = 0; level < other.levels.size(); ++level) {
+            levels[level].insert(levels[level].end(), other.levels[level].begin(), other.levels[level].end());
+        }
+        count += other.count;
+        size += other.size;
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+        exactLimit = std::max(exactLimit, other.exactLimit);
+        compress();
+    }
+
+    double QuantileSketch::quantile(double q) const {
+        if (!(q >= 0.0 && q <= 1.0)) {
+            throw std::invalid_argument("Quantile has to be in [0, 1]");
+        }
+        if (count == 0) {
+            throw std::invalid_argument("Cannot calculate quantiles of an empty sketch");
+        }
+        if (q == 0.0) return minValue;
+        if (q == 1.0) return maxValue;
+
+        if (isExact()) {
+            std::vector<double> values = levels[0];
+            const double h = (values.size() - 1) * q;
+            const std::size_t lower = static_cast<std::size_t>(std::floor(h));
+            std::nth_element(values.begin(), values.begin() + lower, values.end());
+            const double lowerValue = values[lower];
+            if (lower + 1 == values.size()) return lowerValue;
+            const double upperValue = *std::min_element(values.begin() + lower + 1, values.end());
+            return lowerValue + (h - lower) * (upperValue - lowerValue);
+        }
+
+        // Weighted values sorted by value, the quantile is the first value whose cumulated weight reaches q * count
+        std::vector<std::pair<double, long long>> weighted;
+        weighted.reserve(size);
+        for (std::size_t level = 0; level < levels.size(); ++level) {
+            for (double val : levels[level]) weighted.emplace_back(val, 1LL << level);
+        }
+        std::sort(weighted.begin(), weighted.end());
+
+        long long totalWeight = 0;
+        for (const auto& item : weighted) totalWeight += item.second;
+        const double target = q * totalWeight;
+        long long cumulated = 0;
+        for (const auto& [val, weight] : weighted) {
+            cumulated += weight;
+            if (cumulated >= target) return std::clamp(val, minValue, maxValue);
+        }
+        return maxValue;
+    }
+
+    double QuantileSketch::median() const {
+        return quantile(0.5);
+    }
+
+    bool QuantileSketch::isExact() const {
+        return levels.size() == 1;
+    }
+
+    long long QuantileSketch::getCount() const {
+        return count;
+    }
+
+    double QuantileSketch::getMin() const {
+        return minValue;
+    }
+
+    double QuantileSketch::getMax() const {
+        return maxValue;
+    }
+
+}  // namespace descriptiveStatistics
@@ -0,0 +1,367 @@
+#include "SimdKernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MINIML_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace simdKernels {
+
+    namespace {
+        // Scalar versions, used as fallback and for the tails behind the last full vector
+
+        template<typename T>
+        double sumScalar(const T* values, std::size_t n) {
+            double sum = 0;
+            for (std::size_t i = 0; i < n; ++i) sum += values[i];
+            return sum;
+        }
+
+        template<typename T>
+        double sumSquaredDeviationsScalar(const T* values, std::size_t n, double center) {
+            double sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                double diff = values[i] - center;
+                sum += diff * diff;
+            }
+            return sum;
+        }
+
+        template<typename T>
+        MinMax minMaxScalar(const T* values, std::size_t n, MinMax result) {
+            for (std::size_t i = 0; i < n; ++i) {
+                result.min = std::min<double>(result.min, values[i]);
+                result.max = std::max<double>(result.max, values[i]);
+            }
+            return result;
+        }
+
+        template<typename T>
+        double dotScalar(const T* a, const T* b, std::size_t n) {
+            double sum = 0;
+            for (std::size_t i = 0; i < n; ++i) sum += static_cast<double>(a[i]) * b[i];
+            return sum;
+        }
+
+        template<typename T>
+        void standardizeScalar(const T* values, std::size_t n, double center, double scale, double* out) {
+            for (std::size_t i = 0; i < n; ++i) out[i] = (values[i] - center) * scale;
+        }
+
+#ifdef MINIML_X86_SIMD
+#define MINIML_AVX2 __attribute__((target("avx2,fma")))
+#define MINIML_AVX512 __attribute__((target("avx512f,avx2,fma")))
+
+        // AVX2: 4 values per vector, converted to double while loading
+
+        MINIML_AVX2 inline __m256d load4(const double* p) { return _mm256_loadu_pd(p); }
+        MINIML_AVX2 inline __m256d load4(const float* p) { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+        MINIML_AVX2 inline __m256d load4(const int* p) { return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+
+        MINIML_AVX2 inline double horizontalSum(__m256d v) {
+            __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+        }
+
+        template<typename T>
+        MINIML_AVX2 double sumAvx2(const T* values, std::size_t n) {
+            // Independent accumulators hide the latency of the additions
+            __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd(), acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                acc0 = _mm256_add_pd(acc0, load4(values + i));
+                acc1 = _mm256_add_pd(acc1, load4(values + i + 4));
+                acc2 = _mm256_add_pd(acc2, load4(values + i + 8));
+                acc3 = _mm256_add_pd(acc3, load4(values + i + 12));
+            }
+            for (; i + 4 <= n; i += 4) acc0 = _mm256_add_pd(acc0, load4(values + i));
+            __m256d acc = _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3));
+            return horizontalSum(acc) + sumScalar(values + i, n - i);
+        }
+
+        template<typename T>
+        MINIML_AVX2 double sumSquaredDeviationsAvx2(const T* values, std::size_t n, double center) {
+            const __m256d c = _mm256_set1_pd(center);
+            __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd(), acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                __m256d d0 = _mm256_sub_pd(load4(values + i), c);
+                __m256d d1 = _mm256_sub_pd(load4(values + i + 4), c);
+                __m256d d2 = _mm256_sub_pd(load4(values + i + 8), c);
+                __m256d d3 = _mm256_sub_pd(load4(values + i + 12), c);
+                acc0 = _mm256_fmadd_pd(d0, d0, acc0);
+                acc1 = _mm256_fmadd_pd(d1, d1, acc1);
+                acc2 = _mm256_fmadd_pd(d2, d2, acc2);
+                acc3 = _mm256_fmadd_pd(d3, d3, acc3);
+            }
+            for (; i + 4 <= n; i += 4) {
+                __m256d d = _mm256_sub_pd(load4(values + i), c);
+                acc0 = _mm256_fmadd_pd(d, d, acc0);
+            }
+            __m256d acc = _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3));
+            return horizontalSum(acc) + sumSquaredDeviationsScalar(values + i, n - i, center);
+        }
+
+        template<typename T>
+        MINIML_AVX2 MinMax minMaxAvx2(const T* values, std::size_t n) {
+            MinMax result = {static_cast<double>(values[0]), static_cast<double>(values[0])};
+            std::size_t i = 0;
+            if (n >= 4) {
+                __m256d min = load4(values), max = min;
+                for (i = 4; i + 4 <= n; i += 4) {
+                    __m256d v = load4(values + i);
+                    min = _mm256_min_pd(min, v);
+                    max = _mm256_max_pd(max, v);
+                }
+                alignas(32) double mins[4], maxs[4];
+                _mm256_store_pd(mins, min);
+                _mm256_store_pd(maxs, max);
+                result = minMaxScalar(mins, 4, result);
+                result = minMaxScalar(maxs, 4, result);
+            }
+            return minMaxScalar(values + i, n - i, result);
+        }
+
+        template<typename T>
+        MINIML_AVX2 double dotAvx2(const T* a, const T* b, std::size_t n) {
+            __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                acc0 = _mm256_fmadd_pd(load4(a + i), load4(b + i), acc0);
+                acc1 = _mm256_fmadd_pd(load4(a + i + 4), load4(b + i + 4), acc1);
+            }
+            for (; i + 4 <= n; i += 4) acc0 = _mm256_fmadd_pd(load4(a + i), load4(b + i), acc0);
+            return horizontalSum(_mm256_add_pd(acc0, acc1)) + dotScalar(a + i, b + i, n - i);
+        }
+
+        template<typename T>
+        MINIML_AVX2 void standardizeAvx2(const T* values, std::size_t n, double center, double scale, double* out) {
+            const __m256d c = _mm256_set1_pd(center);
+            const __m256d s = _mm256_set1_pd(scale);
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                // Both vectors are loaded before storing, so that out may be the same memory as values
+                __m256d v0 = load4(values + i);
+                __m256d v1 = load4(values + i + 4);
+                _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_sub_pd(v0, c), s));
+                _mm256_storeu_pd(out + i + 4, _mm256_mul_pd(_mm256_sub_pd(v1, c), s));
+            }
+            for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_sub_pd(load4(values + i), c), s));
+            standardizeScalar(values + i, n - i, center, scale, out + i);
+        }
+
+        // AVX-512: 8 values per vector
+
+        MINIML_AVX512 inline __m512d load8(const double* p) { return _mm512_loadu_pd(p); }
+        MINIML_AVX512 inline __m512d load8(const float* p) { return _mm512_cvtps_pd(_mm256_loadu_ps(p)); }
+        MINIML_AVX512 inline __m512d load8(const int* p) { return _mm512_cvtepi32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+
+        template<typename T>
+        MINIML_AVX512 double sumAvx512(const T* values, std::size_t n) {
+            __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd(), acc2 = _mm512_setzero_pd(), acc3 = _mm512_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                acc0 = _mm512_add_pd(acc0, load8(values + i));
+                acc1 = _mm512_add_pd(acc1, load8(values + i + 8));
+                acc2 = _mm512_add_pd(acc2, load8(values + i + 16));
+                acc3 = _mm512_add_pd(acc3, load8(values + i + 24));
+            }
+            for (; i + 8 <= n; i += 8) acc0 = _mm512_add_pd(acc0, load8(values + i));
+            __m512d acc = _mm512_add_pd(_mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3));
+            return _mm512_reduce_add_pd(acc) + sumScalar(values + i, n - i);
+        }
+
+        template<typename T>
+        MINIML_AVX512 double sumSquaredDeviationsAvx512(const T* values, std::size_t n, double center) {
+            const __m512d c = _mm512_set1_pd(center);
+            __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd(), acc2 = _mm512_setzero_pd(), acc3 = _mm512_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                __m512d d0 = _mm512_sub_pd(load8(values + i), c);
+                __m512d d1 = _mm512_sub_pd(load8(values + i + 8), c);
+                __m512d d2 = _mm512_sub_pd(load8(values + i + 16), c);
+                __m512d d3 = _mm512_sub_pd(load8(values + i + 24), c);
+                acc0 = _mm512_fmadd_pd(d0, d0, acc0);
+                acc1 = _mm512_fmadd_pd(d1, d1, acc1);
+                acc2 = _mm512_fmadd_pd(d2, d2, acc2);
+                acc3 = _mm512_fmadd_pd(d3, d3, acc3);
+            }
+            for (; i + 8 <= n; i += 8) {
+                __m512d d = _mm512_sub_pd(load8(values + i), c);
+                acc0 = _mm512_fmadd_pd(d, d, acc0);
+            }
+            __m512d acc = _mm512_add_pd(_mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3));
+            return _mm512_reduce_add_pd(acc) + sumSquaredDeviationsScalar(values + i, n - i, center);
+        }
+
+        template<typename T>
+        MINIML_AVX512 MinMax minMaxAvx512(const T* values, std::size_t n) {
+            MinMax result = {static_cast<double>(values[0]), static_cast<double>(values[0])};
+            std::size_t i = 0;
+            if (n >= 8) {
+                __m512d min = load8(values), max = min;
+                for (i = 8; i + 8 <= n; i += 8) {
+                    __m512d v = load8(values + i);
+                    min = _mm512_min_pd(min, v);
+                    max = _mm512_max_pd(max, v);
+                }
+                alignas(64) double mins[8], maxs[8];
+                _mm512_store_pd(mins, min);
+                _mm512_store_pd(maxs, max);
+                result = minMaxScalar(mins, 8, result);
+                result = minMaxScalar(maxs, 8, result);
+            }
+            return minMaxScalar(values + i, n - i, result);
+        }
+
+        template<typename T>
+        MINIML_AVX512 double dotAvx512(const T* a, const T* b, std::size_t n) {
+            __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                acc0 = _mm512_fmadd_pd(load8(a + i), load8(b + i), acc0);
+                acc1 = _mm512_fmadd_pd(load8(a + i + 8), load8(b + i + 8), acc1);
+            }
+            for (; i + 8 <= n; i += 8) acc0 = _mm512_fmadd_pd(load8(a + i), load8(b + i), acc0);
+            return _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1)) + dotScalar(a + i, b + i, n - i);
+        }
+
+        template<typename T>
+        MINIML_AVX512 void standardizeAvx512(const T* values, std::size_t n, double center, double scale, double* out) {
+            const __m512d c = _mm512_set1_pd(center);
+            const __m512d s = _mm512_set1_pd(scale);
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                __m512d v0 = load8(values + i);
+                __m512d v1 = load8(values + i + 8);
+                _mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_sub_pd(v0, c), s));
+                _mm512_storeu_pd(out + i + 8, _mm512_mul_pd(_mm512_sub_pd(v1, c), s));
+            }
+            for (; i + 8 <= n; i += 8) _mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_sub_pd(load8(values + i), c), s));
+            standardizeScalar(values + i, n - i, center, scale, out + i);
+        }
+#endif
+
+        SimdLevel detectLevel() {
+#ifdef MINIML_X86_SIMD
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::AVX2;
+#endif
+            return SimdLevel::Scalar;
+        }
+
+        std::atomic<SimdLevel>& activeLevel() {
+            static std::atomic<SimdLevel> level{detectSimdLevel()};
+            return level;
+        }
+    }
+
+    SimdLevel detectSimdLevel() {
+        static const SimdLevel level = detectLevel();
+        return level;
+    }
+
+    SimdLevel getSimdLevel() {
+        return activeLevel().load(std::memory_order_relaxed);
+    }
+
+    void setSimdLevel(SimdLevel level) {
+        if (static_cast<int>(level) > static_cast<int>(detectSimdLevel())) {
+            throw std::invalid_argument("The instruction set is not supported by this CPU");
+        }
+        activeLevel().store(level, std::memory_order_relaxed);
+    }
+
+    template<typename T>
+    double sum(std::span<const T> values) {
+#ifdef MINIML_X86_SIMD
+        switch (getSimdLevel()) {
+            case SimdLevel::AVX512: return sumAvx512(values.data(), values.size());
+            case SimdLevel::AVX2: return sumAvx2(values.data(), values.size());
+            default: break;
+        }
+#endif
+        return sumScalar(values.data(), values.size());
+    }
+
+    template<typename T>
+    double sumSquaredDeviations(std::span<const T> values, double center) {
+#ifdef MINIML_X86_SIMD
+        switch (getSimdLevel()) {
+            case SimdLevel::AVX512: return sumSquaredDeviationsAvx512(values.data(), values.size(), center);
+            case SimdLevel::AVX2: return sumSquaredDeviationsAvx2(values.data(), values.size(), center);
+            default: break;
+        }
+#endif
+        return sumSquaredDeviationsScalar(values.data(), values.size(), center);
+    }
+
+    template<typename T>
+    MinMax minMax(std::span<const T> values) {
+        if (values.empty()) {
+            throw std::invalid_argument("Cannot calculate minimum and maximum of no values");
+        }
+#ifdef MINIML_X86_SIMD
+        switch (getSimdLevel()) {
+            case SimdLevel::AVX512: return minMaxAvx512(values.data(), values.size());
+            case SimdLevel::AVX2: return minMaxAvx2(values.data(), values.size());
+            default: break;
+        }
+#endif
+        MinMax start = {static_cast<double>(values[0]), static_cast<double>(values[0])};
+        return minMaxScalar(values.data(), values.size(), start);
+    }
+
+    template<typename T>
+    double dot(std::span<const T> a, std::span<const T> b) {
+        if (a.size() != b.size()) {
+            throw std::invalid_argument("Cannot calculate the dot product of vectors with different lengths");
+        }
+#ifdef MINIML_X86_SIMD
+        switch (getSimdLevel()) {
+            case SimdLevel::AVX512: return dotAvx512(a.data(), b.data(), a.size());
+            case SimdLevel::AVX2: return dotAvx2(a.data(), b.data(), a.size());
+            default: break;
+        }
+#endif
+        return dotScalar(a.data(), b.data(), a.size());
+    }
+
+    template<typename T>
+    void standardize(std::span<const T> values, double center, double scale, std::span<double> out) {
+        if (values.size() != out.size()) {
+            throw std::invalid_argument("Input and output of standardize need to have the same length");
+        }
+#ifdef MINIML_X86_SIMD
+        switch (getSimdLevel()) {
+            case SimdLevel::AVX512: return standardizeAvx512(values.data(), values.size(), center, scale, out.data());
+            case SimdLevel::AVX2: return standardizeAvx2(values.data(), values.size(), center, scale, out.data());
+            default: break;
+        }
+#endif
+        standardizeScalar(values.data(), values.size(), center, scale, out.data());
+    }
+
+    template double sum<int>(std::span<const int>);
+    template double sum<float>(std::span<const float>);
+    template double sum<double>(std::span<const double>);
+    template double sumSquaredDeviations<int>(std::span<const int>, double);
+    template double sumSquaredDeviations<float>(std::span<const float>, double);
+    template double sumSquaredDeviations<double>(std::span<const double>, double);
+    template MinMax minMax<int>(std::span<const int>);
+    template MinMax minMax<float>(std::span<const float>);
+    template MinMax minMax<double>(std::span<const double>);
+    template double dot<int>(std::span<const int>, std::span<const int>);
+    template double dot<float>(std::span<const float>, std::span<const float>);
+    template double dot<double>(std::span<const double>, std::span<const double>);
+    template void standardize<int>(std::span<const int>, double, double, std::span<double>);
+    template void standardize<float>(std::span<const float>, double, double, std::span<double>);
+    template void standardize<double>(std::span<const double>, double, double, std::span<double>);
+
+}  // namespace simdKernels
@@ -1,52 +1,183 @@
 
 #include "StandardScaler.hpp"
 
+#include <algorithm>
+
+#include "SimdKernels.hpp"
+#include "ThreadPool.hpp"
+
+namespace {
+    // Number of values per task on the thread pool in scaleColumns
+    constexpr int chunkSize = 1 << 16;
+}
+
 StandardScaler::StandardScaler() = default;
 
 void StandardScaler::fit(DataFrame& df) {
-    means = descriptiveStatistics::means(df);
-    stdev = descriptiveStatistics::standardDeviations(df);
+    if(df.empty()) {
+        throw std::invalid_argument("Cannot fit StandardScaler on empty DataFrame.");
+    }
+
+    // Means and standard deviations from a single pass over every column
+    summaries = descriptiveStatistics::describe(df);
+    updateFromSummaries();
     hasFitted = true;
 }
 
-DataFrame StandardScaler::transform(DataFrame& df) {
+void StandardScaler::partialFit(DataFrame& df) {
+    if(!hasFitted) {
+        fit(df);
+        return;
+    }
+    if(df.empty()) {
+        throw std::invalid_argument("Cannot fit StandardScaler on empty DataFrame.");
+    }
+    if(summaries.size() != df.getDim().second) {
+        throw std::invalid_argument("Input data needs to have the same number of columns, then the data, which was used in fit!");
+    }
 
+    std::vector<descriptiveStatistics::ColumnSummary> batchSummaries = descriptiveStatistics::describe(df);
+    for(unsigned int i = 0; i < summaries.size(); i++) {
+        summaries[i].merge(batchSummaries[i]);
+    }
+    updateFromSummaries();
+}
+
+void StandardScaler::merge(const StandardScaler& other) {
+    if(!other.hasFitted) return;
+    if(!hasFitted) {
+        *this = other;
+        return;
+    }
+    if(summaries.size() != other.summaries.size()) {
+        throw std::invalid_argument("Only StandardScalers fitted on the same columns can be merged");
+    }
+
+    for(unsigned int i = 0; i < summaries.size(); i++) {
+        summaries[i].merge(other.summaries[i]);
+    }
+    updateFromSummaries();
+}
+
+void StandardScaler::updateFromSummaries() {
+    means.clear();
+    stdev.clear();
+    for(const descriptiveStatistics::ColumnSummary& summary : summaries) {
+        means.push_back(summary.mean);
+        stdev.push_back(summary.standardDeviation());
+    }
+}
+
+bool StandardScaler::checkInput(const DataFrame& df) const {
     if(!hasFitted) throw std::runtime_error("StandardScaler has to be fitted first, before transforming data!");
 
     if(means.size() != df.getDim().second) {
         throw std::runtime_error("Input data needs to have the same number of columns, then the data, which was used in fit!");
     }
 
-    DataFrame scaledDf;
     if(df.empty()) {
         std::cerr << "Warning: Input DataFrame was empty!" << std::endl;
-        return(scaledDf);
+        return(false);
     }
 
-    int n = df.getDim().first;
-    std::vector<std::string> colnames = df.getColNames();    
-
-    int i = 0;
-    for(std::string colname : colnames) {
-        std::vector<double> scaledColumn(n); 
-        std::vector<double> column = df.getColumn(colname).getDataAsDouble();
+    std::vector<std::string> colnames = df.getColNames();
+    for(int i = 0; i < df.getDim().second; i++) {
         if(stdev[i] == 0) {
-            scaledColumn = column;
-            std::cerr << "[Warning] Cannot scale column: " + colname + ", because the standard deviation is 0 (please check if the column is constant)" << std::endl;
-        } else {
-            for(int j = 0; j < n; j++) {
-                scaledColumn[j] = (column[j] - means[i]) / stdev[i];
-            }
+            std::cerr << "[Warning] Cannot scale column: " + colnames[i] + ", because the standard deviation is 0 (please check if the column is constant)" << std::endl;
         }
-        scaledDf.addColumn(scaledColumn, colname);
-        i++;
     }
+    return(true);
+}
 
-    scaledDf.setRowNames(df.getRowNames());
+void StandardScaler::scaleColumns(const DataFrame& df, const std::vector<double*>& outData) const {
+    int n = df.getDim().first;
+    int p = df.getDim().second;
+
+    // The columns are scaled in chunks in parallel, with a single multiplication per value
+    const int chunksPerCol = (n + chunkSize - 1) / chunkSize;
+    ThreadPool::global().parallelFor(p * chunksPerCol, [&](int task) {
+        const int i = task / chunksPerCol;
+        const int begin = (task % chunksPerCol) * chunkSize;
+        const int end = std::min(n, begin + chunkSize);
+        // Columns with a standard deviation of 0 are copied unchanged
+        const double center = stdev[i] == 0 ? 0.0 : means[i];
+        const double scale = stdev[i] == 0 ? 1.0 : 1.0 / stdev[i];
+        std::span<double> out(outData[i] + begin, end - begin);
+        df.getColumn(i).visit([&](auto data) {
+            simdKernels::standardize(data.subspan(begin, end - begin), center, scale, out);
+        });
+    });
+}
 
+DataFrame StandardScaler::transform(DataFrame& df) {
+    DataFrame scaledDf;
+    transformInto(df, scaledDf);
     return(scaledDf);
 }
 
+void StandardScaler::transformInPlace(DataFrame& df) {
+    if(!checkInput(df)) return;
+
+    int n = df.getDim().first;
+    int p = df.getDim().second;
+
+    // Double columns are scaled in their own storage, the other columns get a new Double column, which replaces them afterwards
+    std::vector<double*> outData;
+    std::vector<std::pair<int, Column>> convertedColumns;
+    for(int i = 0; i < p; i++) {
+        if(df.getColumnType(i) == ColumnType::Double) {
+            outData.push_back(df.getColumnSpan<double>(i).data());
+            continue;
+        }
+        Column col(ColumnType::Double);
+        col.resize(n);
+        outData.push_back(col.getSpan<double>().data());
+        convertedColumns.emplace_back(i, std::move(col));
+    }
+
+    scaleColumns(df, outData);
+
+    for(const auto& [i, col] : convertedColumns) {
+        df.setColumn(i, col);
+    }
+}
+
+void StandardScaler::transformInto(const DataFrame& df, DataFrame& out) {
+    if(&df == &out) {
+        transformInPlace(out);
+        return;
+    }
+    if(!checkInput(df)) {
+        out = DataFrame();
+        return;
+    }
+
+    int n = df.getDim().first;
+    int p = df.getDim().second;
+    std::vector<std::string> colnames = df.getColNames();
+
+    // The buffers of out are only reused, if out has the layout of the result
+    bool reusable = out.getDim() == df.getDim() && out.hasRowNames() == df.hasRowNames() && out.getColNames() == colnames;
+    for(int i = 0; reusable && i < p; i++) {
+        reusable = out.getColumnType(i) == ColumnType::Double;
+    }
+    if(!reusable) {
+        out = DataFrame();
+        for(int i = 0; i < p; i++) {
+            Column col(ColumnType::Double);
+            col.resize(n);
+            out.addColumn(col, colnames[i]);
+        }
+    }
+    if(df.hasRowNames()) out.setRowNames(df.getRowNames());
+
+    std::vector<double*> outData;
+    for(int i = 0; i < p; i++) {
+        outData.push_back(out.getColumnSpan<double>(i).data());
+    }
+    scaleColumns(df, outData);
+}
+
 DataFrame StandardScaler::fitTransform(DataFrame& df) {
     fit(df);
     return(transform(df));
@@ -0,0 +1,130 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <exception>
+#include <stdexcept>
+
+struct ThreadPool::Job {
+    const std::function<void(int)>* task = nullptr;
+    int nrTasks = 0;
+    // Next index, which is not taken yet
+    std::atomic<int> next{0};
+    // Guarded by the mutex of the pool
+    int finished = 0;
+    std::exception_ptr error;
+    int errorIndex = INT_MAX;
+    std::condition_variable done;
+};
+
+namespace {
+    std::mutex globalMutex;
+    std::unique_ptr<ThreadPool> globalPool;
+}
+
+ThreadPool::ThreadPool(int numThreads) {
+    if (numThreads < 0) {
+        throw std::invalid_argument("Number of threads cannot be negative");
+    }
+    if (numThreads == 0) {
+        numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    workers.reserve(numThreads - 1);
+    for (int i = 0; i < numThreads - 1; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+int ThreadPool::getNumThreads() const {
+    return static_cast<int>(workers.size()) + 1;
+}
+
+void ThreadPool::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workAvailable.wait(lock, [this]() { return stopping || !jobs.empty(); });
+        if (jobs.empty()) return;
+
+        std::shared_ptr<Job> job = jobs.front();
+        if (job->next.load() >= job->nrTasks) {
+            // All indices are taken, the job only waits for running tasks
+            jobs.pop_front();
+            continue;
+        }
+        lock.unlock();
+        runTasks(*job);
+        lock.lock();
+    }
+}
+
+void ThreadPool::runTasks(Job& job) {
+    while (true) {
+        const int index = job.next.fetch_add(1);
+        if (index >= job.nrTasks) return;
+
+        std::exception_ptr error;
+        try {
+            (*job.task)(index);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (error && index < job.errorIndex) {
+            job.error = error;
+            job.errorIndex = index;
+        }
+        if (++job.finished == job.nrTasks) job.done.notify_all();
+    }
+}
+
+void ThreadPool::parallelFor(int nrTasks, const std::function<void(int)>& task) {
+    if (nrTasks <= 0) return;
+    if (workers.empty() || nrTasks == 1) {
+        for (int i = 0; i < nrTasks; ++i) task(i);
+        return;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->task = &task;
+    job->nrTasks = nrTasks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(job);
+    }
+    workAvailable.notify_all();
+
+    // The calling thread works on its own job, instead of only waiting for it
+    runTasks(*job);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = std::find(jobs.begin(), jobs.end(), job);
+    if (it != jobs.end()) jobs.erase(it);
+    job->done.wait(lock, [&job]() { return job->finished == job->nrTasks; });
+
+    if (job->error) std::rethrow_exception(job->error);
+}
+
+ThreadPool& ThreadPool::global() {
+    std::lock_guard<std::mutex> lock(globalMutex);
+    if (!globalPool) globalPool = std::make_unique<ThreadPool>();
+    return *globalPool;
+}
+
+void ThreadPool::setGlobalNumThreads(int numThreads) {
+    auto pool = std::make_unique<ThreadPool>(numThreads);
+    std::lock_guard<std::mutex> lock(globalMutex);
+    globalPool = std::move(pool);
+}